@@ -0,0 +1,217 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifdef SMALLVEC_BENCH_ABSL
+#include <absl/container/inlined_vector.h>
+#endif
+#ifdef SMALLVEC_BENCH_BOOST
+#include <boost/container/small_vector.hpp>
+#endif
+#ifdef SMALLVEC_BENCH_LLVM
+#include <llvm/ADT/SmallVector.h>
+#endif
+
+#include "CachingAllocator.hpp"
+#include "SmallVec.hpp"
+
+namespace {
+// Adapters over the differing container APIs
+
+template <typename Vec, typename U>
+void pushBack(Vec &vec, U &&value) {
+  if constexpr (requires { vec.push(std::forward<U>(value)); })
+    vec.push(std::forward<U>(value));
+  else
+    vec.push_back(std::forward<U>(value));
+}
+
+template <typename Vec>
+void reserveTotal(Vec &vec, std::size_t total) {
+  if constexpr (requires { vec.reserveExact(total); })
+    vec.reserveExact(total - vec.size());
+  else
+    vec.reserve(total);
+}
+
+template <typename Vec>
+void shrinkToFit(Vec &vec) {
+  if constexpr (requires { vec.shrink(); })
+    vec.shrink();
+  else if constexpr (requires { vec.shrink_to_fit(); })
+    vec.shrink_to_fit();
+}
+
+template <typename Vec, typename T>
+bool containsValue(const Vec &vec, const T &value) {
+  if constexpr (requires { vec.contains(value); })
+    return vec.contains(value);
+  else
+    return std::find(vec.begin(), vec.end(), value) != vec.end();
+}
+
+template <typename Vec>
+using ValueOf = std::remove_cvref_t<decltype(*std::declval<Vec &>().begin())>;
+
+template <typename T>
+T makeValue(std::size_t i) {
+  if constexpr (std::is_same_v<T, std::string>)
+    return "benchmark value " + std::to_string(i);
+  else
+    return static_cast<T>(i);
+}
+
+template <typename Vec>
+Vec filled(std::size_t n) {
+  Vec vec;
+  for (std::size_t i = 0; i < n; i++)
+    pushBack(vec, makeValue<ValueOf<Vec>>(i));
+  return vec;
+}
+
+template <typename Vec>
+void BM_Construct(benchmark::State &state) {
+  for (auto _ : state) {
+    Vec vec;
+    benchmark::DoNotOptimize(vec);
+  }
+}
+
+template <typename Vec>
+void BM_Push(benchmark::State &state) {
+  auto n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    Vec vec;
+    for (std::size_t i = 0; i < n; i++)
+      pushBack(vec, makeValue<ValueOf<Vec>>(i));
+    benchmark::DoNotOptimize(vec.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vec>
+void BM_GrowShrink(benchmark::State &state) {
+  auto n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto vec = filled<Vec>(n);
+    state.ResumeTiming();
+    reserveTotal(vec, 4 * n);
+    shrinkToFit(vec);
+    benchmark::DoNotOptimize(vec.data());
+  }
+}
+
+template <typename Vec>
+void BM_Copy(benchmark::State &state) {
+  auto source = filled<Vec>(state.range(0));
+  for (auto _ : state) {
+    Vec copy(source);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vec>
+void BM_Move(benchmark::State &state) {
+  auto source = filled<Vec>(state.range(0));
+  for (auto _ : state) {
+    Vec moved(std::move(source));
+    benchmark::DoNotOptimize(moved.data());
+    source = std::move(moved);
+  }
+}
+
+template <typename Vec>
+void BM_Iterate(benchmark::State &state) {
+  auto vec = filled<Vec>(state.range(0));
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (const auto &item : vec) {
+      if constexpr (std::is_same_v<ValueOf<Vec>, std::string>)
+        sum += item.size();
+      else
+        sum += item;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vec>
+void BM_Contains(benchmark::State &state) {
+  auto vec = filled<Vec>(state.range(0));
+  // a miss scans the whole vector
+  auto missing = makeValue<ValueOf<Vec>>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec.data());
+    benchmark::DoNotOptimize(containsValue(vec, missing));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// sizes around the inline capacity of the vectors below
+void intSizes(benchmark::internal::Benchmark *bench) {
+  bench->Arg(4)->Arg(16)->Arg(17)->Arg(64)->Arg(1024);
+}
+
+void stringSizes(benchmark::internal::Benchmark *bench) {
+  bench->Arg(4)->Arg(8)->Arg(9)->Arg(64);
+}
+}// namespace
+
+using SmallVecInt = smallvec::SmallVec<int, 16>;
+using SmallVecString = smallvec::SmallVec<std::string, 8>;
+using PointerLayoutInt = smallvec::PointerLayoutSmallVec<int, 16>;
+using PointerLayoutString = smallvec::PointerLayoutSmallVec<std::string, 8>;
+using CachingInt = smallvec::CachingSmallVec<int, 16>;
+using CachingString = smallvec::CachingSmallVec<std::string, 8>;
+using VectorInt = std::vector<int>;
+using VectorString = std::vector<std::string>;
+
+#define SMALLVEC_BENCHMARKS(Vec, Sizes)                  \
+  BENCHMARK_TEMPLATE(BM_Construct, Vec);                 \
+  BENCHMARK_TEMPLATE(BM_Push, Vec)->Apply(Sizes);       \
+  BENCHMARK_TEMPLATE(BM_GrowShrink, Vec)->Apply(Sizes); \
+  BENCHMARK_TEMPLATE(BM_Copy, Vec)->Apply(Sizes);       \
+  BENCHMARK_TEMPLATE(BM_Move, Vec)->Apply(Sizes);       \
+  BENCHMARK_TEMPLATE(BM_Iterate, Vec)->Apply(Sizes);   \
+  BENCHMARK_TEMPLATE(BM_Contains, Vec)->Apply(Sizes)
+
+SMALLVEC_BENCHMARKS(SmallVecInt, intSizes);
+SMALLVEC_BENCHMARKS(SmallVecString, stringSizes);
+SMALLVEC_BENCHMARKS(PointerLayoutInt, intSizes);
+SMALLVEC_BENCHMARKS(PointerLayoutString, stringSizes);
+SMALLVEC_BENCHMARKS(CachingInt, intSizes);
+SMALLVEC_BENCHMARKS(CachingString, stringSizes);
+SMALLVEC_BENCHMARKS(VectorInt, intSizes);
+SMALLVEC_BENCHMARKS(VectorString, stringSizes);
+
+#ifdef SMALLVEC_BENCH_ABSL
+using AbslInt = absl::InlinedVector<int, 16>;
+using AbslString = absl::InlinedVector<std::string, 8>;
+SMALLVEC_BENCHMARKS(AbslInt, intSizes);
+SMALLVEC_BENCHMARKS(AbslString, stringSizes);
+#endif
+
+#ifdef SMALLVEC_BENCH_BOOST
+using BoostInt = boost::container::small_vector<int, 16>;
+using BoostString = boost::container::small_vector<std::string, 8>;
+SMALLVEC_BENCHMARKS(BoostInt, intSizes);
+SMALLVEC_BENCHMARKS(BoostString, stringSizes);
+#endif
+
+#ifdef SMALLVEC_BENCH_LLVM
+using LlvmInt = llvm::SmallVector<int, 16>;
+using LlvmString = llvm::SmallVector<std::string, 8>;
+SMALLVEC_BENCHMARKS(LlvmInt, intSizes);
+SMALLVEC_BENCHMARKS(LlvmString, stringSizes);
+#endif
+
+BENCHMARK_MAIN();
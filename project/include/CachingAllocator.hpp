@@ -0,0 +1,226 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "SmallVec.hpp"
+
+// Largest buffer kept by the cache, in bytes. Bigger buffers go straight to operator new/delete
+#ifndef SMALLVEC_CACHE_MAX_BYTES
+#define SMALLVEC_CACHE_MAX_BYTES 65536
+#endif
+
+// Buffers kept per size class and thread
+#ifndef SMALLVEC_CACHE_BLOCKS_PER_CLASS
+#define SMALLVEC_CACHE_BLOCKS_PER_CLASS 16
+#endif
+
+namespace smallvec {
+// counters of the calling thread's buffer cache
+struct BufferCacheStats {
+  // allocations served from the cache
+  std::size_t hits = 0;
+  // allocations which went to operator new
+  std::size_t misses = 0;
+  // deallocations kept for reuse
+  std::size_t recycled = 0;
+  // deallocations passed on to operator delete, because the buffer was too large or its class full
+  std::size_t released = 0;
+  // bytes currently held by the cache
+  std::size_t cachedBytes = 0;
+};
+
+namespace detail {
+// Per-thread free lists of heap buffers, one per power of two size class.
+// Freed buffers are linked through their first bytes, so the cache needs no memory of its own
+class BufferCache {
+  static constexpr std::size_t minClassBytes = 16;
+  static constexpr std::size_t maxClassBytes = std::bit_ceil(std::size_t(SMALLVEC_CACHE_MAX_BYTES));
+  static constexpr std::size_t classCount = std::bit_width(maxClassBytes) - std::bit_width(minClassBytes) + 1;
+  static constexpr std::size_t blocksPerClass = SMALLVEC_CACHE_BLOCKS_PER_CLASS;
+
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  struct SizeClass {
+    FreeBlock *head = nullptr;
+    std::size_t count = 0;
+  };
+
+  std::array<SizeClass, classCount> classes{};
+  BufferCacheStats counters;
+
+  // set once the thread's cache is destroyed, buffers freed by later thread_local
+  // destructors go straight to operator delete
+  static inline thread_local bool destroyed = false;
+
+  BufferCache() = default;
+
+  static std::size_t classBytes(std::size_t bytes) {
+    return std::max(std::bit_ceil(bytes), minClassBytes);
+  }
+
+  static std::size_t classIndex(std::size_t classBytes) {
+    return static_cast<std::size_t>(std::bit_width(classBytes) - std::bit_width(minClassBytes));
+  }
+
+public:
+  BufferCache(const BufferCache &) = delete;
+  BufferCache &operator=(const BufferCache &) = delete;
+
+  ~BufferCache() {
+    trim();
+    destroyed = true;
+  }
+
+  // nullptr once the calling thread is exiting
+  static BufferCache *local() noexcept {
+    if (destroyed)
+      return nullptr;
+    static thread_local BufferCache cache;
+    return &cache;
+  }
+
+  // returns the buffer and its usable size, which is the whole size class for cached sizes
+  std::pair<void *, std::size_t> allocate(std::size_t bytes) {
+    if (bytes > maxClassBytes) {
+      counters.misses++;
+      return {::operator new(bytes), bytes};
+    }
+    auto size = classBytes(bytes);
+    auto &sizeClass = classes[classIndex(size)];
+    if (auto *block = sizeClass.head) {
+      sizeClass.head = block->next;
+      sizeClass.count--;
+      counters.hits++;
+      counters.cachedBytes -= size;
+      return {block, size};
+    }
+    counters.misses++;
+    return {::operator new(size), size};
+  }
+
+  // `bytes` may be anything in the size class handed out by `allocate`
+  void deallocate(void *ptr, std::size_t bytes) noexcept {
+    if (bytes > maxClassBytes) {
+      counters.released++;
+      ::operator delete(ptr, bytes);
+      return;
+    }
+    auto size = classBytes(bytes);
+    auto &sizeClass = classes[classIndex(size)];
+    if (sizeClass.count == blocksPerClass) {
+      counters.released++;
+      ::operator delete(ptr, size);
+      return;
+    }
+    sizeClass.head = ::new (ptr) FreeBlock{sizeClass.head};
+    sizeClass.count++;
+    counters.recycled++;
+    counters.cachedBytes += size;
+  }
+
+  // frees every cached buffer
+  void trim() noexcept {
+    for (std::size_t i = 0; i < classCount; i++) {
+      auto &sizeClass = classes[i];
+      while (auto *block = sizeClass.head) {
+        sizeClass.head = block->next;
+        ::operator delete(static_cast<void *>(block), minClassBytes << i);
+      }
+      sizeClass.count = 0;
+    }
+    counters.cachedBytes = 0;
+  }
+
+  [[nodiscard]] const BufferCacheStats &stats() const noexcept { return counters; }
+
+  void resetStats() noexcept {
+    counters = BufferCacheStats{.cachedBytes = counters.cachedBytes};
+  }
+
+  // sizes passed to operator delete, so that thread exit falls back correctly
+  static std::size_t allocatedBytes(std::size_t bytes) {
+    return bytes > maxClassBytes ? bytes : classBytes(bytes);
+  }
+};
+}// namespace detail
+
+// Allocator which recycles heap buffers through a per-thread cache of power of two
+// size classes, so that vectors which spill and die quickly cost a few pointer
+// operations instead of a malloc/free pair, without contention between threads.
+// The growth policies already produce power of two capacities and `allocateAtLeast`
+// reports the rest of the size class. Buffers may be freed on another thread than
+// the one they came from, they then join that thread's cache.
+//
+// The cache holds at most SMALLVEC_CACHE_BLOCKS_PER_CLASS buffers per class of up to
+// SMALLVEC_CACHE_MAX_BYTES, everything is freed when the thread exits or on `trimBufferCache()`
+template <typename T>
+struct CachingAllocator {
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "the buffer cache does not support over-aligned types");
+
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  CachingAllocator() noexcept = default;
+
+  template <typename U>
+  CachingAllocator(const CachingAllocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return allocateAtLeast(n).ptr;
+  }
+
+  AllocationResult<T *> allocateAtLeast(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+      throw std::bad_array_new_length();
+    auto bytes = n * sizeof(T);
+    if (auto *cache = detail::BufferCache::local()) {
+      auto [memory, size] = cache->allocate(bytes);
+      return {static_cast<T *>(memory), size / sizeof(T)};
+    }
+    auto size = detail::BufferCache::allocatedBytes(bytes);
+    return {static_cast<T *>(::operator new(size)), size / sizeof(T)};
+  }
+
+  void deallocate(T *ptr, std::size_t n) noexcept {
+    if (auto *cache = detail::BufferCache::local())
+      cache->deallocate(ptr, n * sizeof(T));
+    else
+      ::operator delete(static_cast<void *>(ptr), detail::BufferCache::allocatedBytes(n * sizeof(T)));
+  }
+
+  template <typename U>
+  bool operator==(const CachingAllocator<U> &) const noexcept { return true; }
+};
+
+template <typename T, std::size_t N>
+using CachingSmallVec = SmallVec<T, N, CachingAllocator<T>>;
+
+inline BufferCacheStats bufferCacheStats() noexcept {
+  auto *cache = detail::BufferCache::local();
+  return cache ? cache->stats() : BufferCacheStats{};
+}
+
+inline void resetBufferCacheStats() noexcept {
+  if (auto *cache = detail::BufferCache::local())
+    cache->resetStats();
+}
+
+// frees the buffers cached by the calling thread
+inline void trimBufferCache() noexcept {
+  if (auto *cache = detail::BufferCache::local())
+    cache->trim();
+}
+}// namespace smallvec
@@ -0,0 +1,75 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <cstdlib>
+#include <new>
+
+#if defined(SMALLVEC_USE_JEMALLOC)
+#include <jemalloc/jemalloc.h>
+#endif
+
+#include "SmallVec.hpp"
+
+namespace smallvec {
+// Allocator on top of malloc/realloc/free. SmallVec grows trivially relocatable
+// elements with `realloc`, which frequently extends the block in place.
+//
+// Only the requested size is reported as capacity: the slack malloc_usable_size
+// reveals is not ours to write, fortified builds treat it as an overflow. Define
+// SMALLVEC_USE_JEMALLOC to round requests up to jemalloc's size class with `nallocx`
+// before allocating, so that the whole class is requested and used.
+template <typename T>
+struct MallocAllocator {
+  static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not support over-aligned types");
+
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  MallocAllocator() noexcept = default;
+
+  template <typename U>
+  MallocAllocator(const MallocAllocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return allocateAtLeast(n).ptr;
+  }
+
+  AllocationResult<T *> allocateAtLeast(std::size_t n) {
+    auto bytes = goodSize(n * sizeof(T));
+    void *memory = std::malloc(bytes);
+    if (memory == nullptr)
+      throw std::bad_alloc();
+    return {static_cast<T *>(memory), bytes / sizeof(T)};
+  }
+
+  AllocationResult<T *> reallocate(T *ptr, std::size_t, std::size_t n) {
+    auto bytes = goodSize(n * sizeof(T));
+    void *memory = std::realloc(ptr, bytes);
+    if (memory == nullptr)
+      throw std::bad_alloc();
+    return {static_cast<T *>(memory), bytes / sizeof(T)};
+  }
+
+  void deallocate(T *ptr, std::size_t) noexcept {
+    std::free(ptr);
+  }
+
+  template <typename U>
+  bool operator==(const MallocAllocator<U> &) const noexcept { return true; }
+
+private:
+  static std::size_t goodSize(std::size_t bytes) {
+#if defined(SMALLVEC_USE_JEMALLOC)
+    return nallocx(bytes, 0);
+#else
+    return bytes;
+#endif
+  }
+};
+
+template <typename T, std::size_t N>
+using MallocSmallVec = SmallVec<T, N, MallocAllocator<T>>;
+}// namespace smallvec
@@ -0,0 +1,255 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "SmallVec.hpp"
+
+namespace smallvec {
+// Bit-packed vector of bools with inline room for N bits, stored as 64 bit words
+// in a SmallVec so that it spills to the heap like one. Bulk operations work on
+// whole words, bits past size() in the last word are always zero
+template <std::size_t N>
+class SmallBitVec {
+  static_assert(N > 0, "SmallBitVec needs inline capacity");
+
+public:
+  using Word = std::uint64_t;
+  static constexpr std::size_t wordBits = 64;
+  static constexpr std::size_t inlineCapacity = N;
+
+private:
+  static constexpr std::size_t inlineWords = (N + wordBits - 1) / wordBits;
+
+  CompactSmallVec<Word, inlineWords> blocks;
+  std::size_t len = 0;
+
+  static constexpr std::size_t wordsFor(std::size_t bits) {
+    return (bits + wordBits - 1) / wordBits;
+  }
+
+public:
+  constexpr SmallBitVec() = default;
+
+  // `n` copies of `value`
+  constexpr explicit SmallBitVec(std::size_t n, bool value = false) {
+    resize(n, value);
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const { return len; }
+
+  [[nodiscard]] constexpr bool empty() const { return len == 0; }
+
+  // bits which fit without allocating
+  [[nodiscard]] constexpr std::size_t capacity() const { return blocks.capacity() * wordBits; }
+
+  [[nodiscard]] constexpr bool onHeap() const { return blocks.onHeap(); }
+  [[nodiscard]] constexpr bool onStack() const { return blocks.onStack(); }
+
+  // the packed bits, bit i lives in word i / 64 at position i % 64
+  constexpr std::span<const Word> words() const {
+    return {blocks.data(), blocks.size()};
+  }
+
+  constexpr void reserve(std::size_t additional) {
+    blocks.reserve(wordsFor(len + additional) - blocks.size());
+  }
+
+  constexpr void clear() noexcept {
+    blocks.clear();
+    len = 0;
+  }
+
+  constexpr void push(bool value) {
+    if (len % wordBits == 0)
+      blocks.push(Word(value));
+    else
+      blocks.back() |= Word(value) << (len % wordBits);
+    len++;
+  }
+
+  // appends the low `count` bits of `word` at once, with at most two word writes
+  constexpr void pushWord(Word word, std::size_t count = wordBits) {
+    assert(count <= wordBits);
+    if (count == 0)
+      return;
+    if (count < wordBits)
+      word &= (Word(1) << count) - 1;
+    auto offset = len % wordBits;
+    if (offset == 0) {
+      blocks.push(word);
+    } else {
+      blocks.back() |= word << offset;
+      if (offset + count > wordBits)
+        blocks.push(word >> (wordBits - offset));
+    }
+    len += count;
+  }
+
+  constexpr void pop() {
+    if (len == 0)
+      return;
+    len--;
+    if (len % wordBits == 0)
+      blocks.pop();
+    else
+      clearTail();
+  }
+
+  constexpr void resize(std::size_t n, bool value = false) {
+    if (n > len) {
+      if (value && len % wordBits != 0)
+        blocks.back() |= ~Word(0) << (len % wordBits);
+      blocks.resize(wordsFor(n), value ? ~Word(0) : Word(0));
+    } else {
+      blocks.resize(wordsFor(n));
+    }
+    len = n;
+    clearTail();
+  }
+
+  [[nodiscard]] constexpr bool test(std::size_t index) const {
+    assert(index < len);
+    return (blocks[index / wordBits] >> (index % wordBits)) & 1;
+  }
+
+  constexpr bool operator[](std::size_t index) const {
+    return test(index);
+  }
+
+  constexpr void set(std::size_t index, bool value = true) {
+    assert(index < len);
+    auto bit = Word(1) << (index % wordBits);
+    if (value)
+      blocks[index / wordBits] |= bit;
+    else
+      blocks[index / wordBits] &= ~bit;
+  }
+
+  constexpr void reset(std::size_t index) {
+    set(index, false);
+  }
+
+  constexpr void flip(std::size_t index) {
+    assert(index < len);
+    blocks[index / wordBits] ^= Word(1) << (index % wordBits);
+  }
+
+  // number of set bits
+  [[nodiscard]] constexpr std::size_t popcount() const {
+    std::size_t result = 0;
+    for (auto word : blocks)
+      result += static_cast<std::size_t>(std::popcount(word));
+    return result;
+  }
+
+  [[nodiscard]] constexpr bool any() const {
+    for (auto word : blocks) {
+      if (word != 0)
+        return true;
+    }
+    return false;
+  }
+
+  [[nodiscard]] constexpr bool none() const { return !any(); }
+
+  [[nodiscard]] constexpr bool all() const { return popcount() == len; }
+
+  // index of the first set bit, size() if there is none
+  [[nodiscard]] constexpr std::size_t findFirstSet() const {
+    return findNextSet(0);
+  }
+
+  // index of the first set bit at or after `from`, size() if there is none
+  [[nodiscard]] constexpr std::size_t findNextSet(std::size_t from) const {
+    if (from >= len)
+      return len;
+    auto index = from / wordBits;
+    auto word = blocks[index] & (~Word(0) << (from % wordBits));
+    while (word == 0) {
+      if (++index == blocks.size())
+        return len;
+      word = blocks[index];
+    }
+    return index * wordBits + static_cast<std::size_t>(std::countr_zero(word));
+  }
+
+  // calls `f` with the index of every set bit in ascending order
+  template <typename F>
+  constexpr void forEachSet(F &&f) const {
+    for (std::size_t index = 0; index < blocks.size(); index++) {
+      for (auto word = blocks[index]; word != 0; word &= word - 1)
+        f(index * wordBits + static_cast<std::size_t>(std::countr_zero(word)));
+    }
+  }
+
+  // Bitwise operations combine vectors of the same size word by word
+
+  constexpr SmallBitVec &operator&=(const SmallBitVec &rhs) {
+    assert(len == rhs.len);
+    for (std::size_t i = 0; i < blocks.size(); i++)
+      blocks[i] &= rhs.blocks[i];
+    return *this;
+  }
+
+  constexpr SmallBitVec &operator|=(const SmallBitVec &rhs) {
+    assert(len == rhs.len);
+    for (std::size_t i = 0; i < blocks.size(); i++)
+      blocks[i] |= rhs.blocks[i];
+    return *this;
+  }
+
+  constexpr SmallBitVec &operator^=(const SmallBitVec &rhs) {
+    assert(len == rhs.len);
+    for (std::size_t i = 0; i < blocks.size(); i++)
+      blocks[i] ^= rhs.blocks[i];
+    return *this;
+  }
+
+  // flips every bit
+  constexpr SmallBitVec &flip() {
+    for (auto &word : blocks)
+      word = ~word;
+    clearTail();
+    return *this;
+  }
+
+  friend constexpr SmallBitVec operator&(SmallBitVec lhs, const SmallBitVec &rhs) {
+    lhs &= rhs;
+    return lhs;
+  }
+
+  friend constexpr SmallBitVec operator|(SmallBitVec lhs, const SmallBitVec &rhs) {
+    lhs |= rhs;
+    return lhs;
+  }
+
+  friend constexpr SmallBitVec operator^(SmallBitVec lhs, const SmallBitVec &rhs) {
+    lhs ^= rhs;
+    return lhs;
+  }
+
+  friend constexpr SmallBitVec operator~(SmallBitVec vec) {
+    vec.flip();
+    return vec;
+  }
+
+  friend constexpr bool operator==(const SmallBitVec &lhs, const SmallBitVec &rhs) {
+    return lhs.len == rhs.len && lhs.blocks == rhs.blocks;
+  }
+
+private:
+  // zeroes the bits of the last word past `len`
+  constexpr void clearTail() {
+    if (len % wordBits != 0)
+      blocks.back() &= (Word(1) << (len % wordBits)) - 1;
+  }
+};
+}// namespace smallvec
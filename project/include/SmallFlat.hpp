@@ -0,0 +1,308 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "SmallVec.hpp"
+
+// Flat associative containers stored in a SmallVec, so that maps of a handful of
+// keys live entirely in the inline buffer and a lookup touches one cache line or two
+namespace smallvec {
+// Orderings of the flat containers
+
+// Default, keys are kept sorted by Compare. Lookups scan linearly up to
+// `linearSearchLimit` keys and binary search above
+struct SortedKeys {};
+
+// Keys are compared with == in insertion order, erase fills the hole with the last element.
+// Compare is unused. Suits tiny maps of keys without an ordering
+struct UnsortedKeys {};
+
+namespace detail {
+struct KeyOfIdentity {
+  template <typename T>
+  constexpr const T &operator()(const T &value) const noexcept { return value; }
+};
+
+struct KeyOfFirst {
+  template <typename Pair>
+  constexpr const auto &operator()(const Pair &pair) const noexcept { return pair.first; }
+};
+
+// shared implementation of SmallFlatSet and SmallFlatMap
+template <typename Value, typename Key, typename KeyOf, std::size_t N, typename Ordering, typename Compare>
+class SmallFlatBase {
+  static_assert(std::is_same_v<Ordering, SortedKeys> || std::is_same_v<Ordering, UnsortedKeys>);
+
+protected:
+  static constexpr bool sorted = std::is_same_v<Ordering, SortedKeys>;
+
+  SmallVec<Value, N> items;
+  [[no_unique_address]] Compare comp;
+
+public:
+  using key_type = Key;
+  using value_type = Value;
+  using key_compare = Compare;
+  using const_iterator = const Value *;
+
+  // sorted lookups below this many keys scan linearly, which beats the unpredictable branches of a binary search
+  static constexpr std::size_t linearSearchLimit = 16;
+
+  constexpr SmallFlatBase() = default;
+
+  constexpr explicit SmallFlatBase(const Compare &comp) : comp(comp) {}
+
+  [[nodiscard]] constexpr std::size_t size() const { return items.size(); }
+
+  [[nodiscard]] constexpr bool empty() const { return items.size() == 0; }
+
+  [[nodiscard]] constexpr std::size_t capacity() const { return items.capacity(); }
+
+  [[nodiscard]] constexpr bool onStack() const { return items.onStack(); }
+
+  constexpr void reserve(std::size_t additional) {
+    items.reserve(additional);
+  }
+
+  constexpr void clear() noexcept {
+    items.clear();
+  }
+
+  constexpr const_iterator begin() const {
+    return items.begin();
+  }
+
+  constexpr const_iterator end() const {
+    return items.end();
+  }
+
+  constexpr const_iterator find(const Key &key) const {
+    return items.begin() + indexOf(key);
+  }
+
+  [[nodiscard]] constexpr bool contains(const Key &key) const {
+    return indexOf(key) != items.size();
+  }
+
+  [[nodiscard]] constexpr std::size_t count(const Key &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  // returns the number of erased elements
+  constexpr std::size_t erase(const Key &key) {
+    auto index = indexOf(key);
+    if (index == items.size())
+      return 0;
+    eraseAt(index);
+    return 1;
+  }
+
+  // returns the element which took the place of the erased one
+  constexpr const_iterator erase(const_iterator pos) {
+    auto index = static_cast<std::size_t>(pos - items.begin());
+    eraseAt(index);
+    return items.begin() + index;
+  }
+
+  // Inserts every element of `range` at once: they are sorted, then merged with the
+  // current elements in a single pass, where one `insert` per element would shift the tail
+  // each time. Keys already present are kept, of equivalent keys within `range` only one is inserted
+  template <std::ranges::input_range R>
+    requires sorted
+  constexpr void insertSorted(R &&range) {
+    SmallVec<Value, N> incoming;
+    incoming.appendRange(std::forward<R>(range));
+    if (incoming.size() == 0)
+      return;
+    auto byKey = [this](const Value &lhs, const Value &rhs) { return comp(KeyOf{}(lhs), KeyOf{}(rhs)); };
+    std::sort(incoming.begin(), incoming.end(), byKey);
+    auto last = std::unique(incoming.begin(), incoming.end(),
+                            [&](const Value &lhs, const Value &rhs) { return !byKey(lhs, rhs) && !byKey(rhs, lhs); });
+
+    SmallVec<Value, N> merged;
+    merged.reserveExact(items.size() + static_cast<std::size_t>(last - incoming.begin()));
+    auto current = items.begin();
+    auto next = incoming.begin();
+    while (current != items.end() && next != last) {
+      if (byKey(*current, *next)) {
+        merged.pushUnchecked(std::move(*current++));
+      } else if (byKey(*next, *current)) {
+        merged.pushUnchecked(std::move(*next++));
+      } else {
+        merged.pushUnchecked(std::move(*current++));
+        ++next;
+      }
+    }
+    merged.extendConsuming(current, items.end());
+    merged.extendConsuming(next, last);
+    items = std::move(merged);
+  }
+
+protected:
+  // Sorted: the index of the first element not ordered before `key`.
+  // Unsorted: the index of the element equal to `key`, or size()
+  constexpr std::size_t lowerBound(const Key &key) const {
+    if constexpr (!sorted) {
+      if constexpr (std::is_same_v<Value, Key>) {
+        // vectorized for arithmetic keys
+        return static_cast<std::size_t>(items.find(key) - items.begin());
+      } else {
+        std::size_t index = 0;
+        while (index < items.size() && !(KeyOf{}(items[index]) == key))
+          index++;
+        return index;
+      }
+    } else if (items.size() <= linearSearchLimit) {
+      std::size_t index = 0;
+      if constexpr (std::is_arithmetic_v<Key>) {
+        // counts the smaller keys without branches, so that the loop vectorizes
+        for (const auto &item : items)
+          index += comp(KeyOf{}(item), key);
+      } else {
+        while (index < items.size() && comp(KeyOf{}(items[index]), key))
+          index++;
+      }
+      return index;
+    } else {
+      auto it = std::partition_point(items.begin(), items.end(), [&](const Value &item) {
+        return comp(KeyOf{}(item), key);
+      });
+      return static_cast<std::size_t>(it - items.begin());
+    }
+  }
+
+  // index of the element with `key`, size() if there is none
+  constexpr std::size_t indexOf(const Key &key) const {
+    auto index = lowerBound(key);
+    if constexpr (sorted) {
+      if (index != items.size() && comp(key, KeyOf{}(items[index])))
+        return items.size();
+    }
+    return index;
+  }
+
+  // inserts the element built from `args` unless `key` is present, returns its index
+  template <typename... Args>
+  constexpr std::pair<std::size_t, bool> tryInsert(const Key &key, Args &&...args) {
+    auto index = lowerBound(key);
+    if (index != items.size() && (!sorted || !comp(key, KeyOf{}(items[index]))))
+      return {index, false};
+    if constexpr (sorted)
+      items.emplace(items.begin() + index, std::forward<Args>(args)...);
+    else
+      items.emplaceBack(std::forward<Args>(args)...);
+    return {index, true};
+  }
+
+  constexpr void eraseAt(std::size_t index) {
+    if constexpr (sorted)
+      items.erase(items.begin() + index);
+    else
+      items.eraseUnordered(items.begin() + index);
+  }
+};
+}// namespace detail
+
+template <typename Key, std::size_t N, typename Ordering = SortedKeys, typename Compare = std::less<Key>>
+class SmallFlatSet : public detail::SmallFlatBase<Key, Key, detail::KeyOfIdentity, N, Ordering, Compare> {
+  using Base = detail::SmallFlatBase<Key, Key, detail::KeyOfIdentity, N, Ordering, Compare>;
+
+public:
+  using iterator = typename Base::const_iterator;
+
+  using Base::Base;
+
+  constexpr std::pair<iterator, bool> insert(const Key &key) {
+    auto [index, inserted] = this->tryInsert(key, key);
+    return {this->items.begin() + index, inserted};
+  }
+
+  constexpr std::pair<iterator, bool> insert(Key &&key) {
+    auto [index, inserted] = this->tryInsert(key, std::move(key));
+    return {this->items.begin() + index, inserted};
+  }
+};
+
+// Elements are std::pair<Key, T>, their keys must not be modified through iterators
+template <typename Key, typename T, std::size_t N, typename Ordering = SortedKeys, typename Compare = std::less<Key>>
+class SmallFlatMap : public detail::SmallFlatBase<std::pair<Key, T>, Key, detail::KeyOfFirst, N, Ordering, Compare> {
+  using Base = detail::SmallFlatBase<std::pair<Key, T>, Key, detail::KeyOfFirst, N, Ordering, Compare>;
+
+public:
+  using mapped_type = T;
+  using iterator = std::pair<Key, T> *;
+
+  using Base::Base;
+  using Base::begin;
+  using Base::end;
+  using Base::find;
+
+  constexpr iterator begin() {
+    return this->items.begin();
+  }
+
+  constexpr iterator end() {
+    return this->items.end();
+  }
+
+  constexpr iterator find(const Key &key) {
+    return this->items.begin() + this->indexOf(key);
+  }
+
+  constexpr std::pair<iterator, bool> insert(const std::pair<Key, T> &value) {
+    auto [index, inserted] = this->tryInsert(value.first, value);
+    return {this->items.begin() + index, inserted};
+  }
+
+  constexpr std::pair<iterator, bool> insert(std::pair<Key, T> &&value) {
+    auto [index, inserted] = this->tryInsert(value.first, std::move(value));
+    return {this->items.begin() + index, inserted};
+  }
+
+  // builds the mapped value from `args` only if `key` is missing
+  template <typename... Args>
+  constexpr std::pair<iterator, bool> tryEmplace(const Key &key, Args &&...args) {
+    auto [index, inserted] = this->tryInsert(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                             std::forward_as_tuple(std::forward<Args>(args)...));
+    return {this->items.begin() + index, inserted};
+  }
+
+  template <typename M>
+  constexpr std::pair<iterator, bool> insertOrAssign(const Key &key, M &&value) {
+    auto result = tryEmplace(key, std::forward<M>(value));
+    if (!result.second)
+      result.first->second = std::forward<M>(value);
+    return result;
+  }
+
+  constexpr T &operator[](const Key &key) {
+    return tryEmplace(key).first->second;
+  }
+
+  constexpr T &at(const Key &key) {
+    auto it = find(key);
+    if (it == end())
+      throw std::out_of_range("SmallFlatMap::at: key not found");
+    return it->second;
+  }
+
+  constexpr const T &at(const Key &key) const {
+    auto it = find(key);
+    if (it == end())
+      throw std::out_of_range("SmallFlatMap::at: key not found");
+    return it->second;
+  }
+};
+}// namespace smallvec
@@ -0,0 +1,530 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "SmallVec.hpp"
+
+namespace smallvec {
+// Structure-of-arrays sibling of SmallVec: every field type gets a column of its own,
+// so that iterating one field reads only that field. All columns share `len` and
+// `cap` and switch from inline to heap storage together, spilling into a single
+// allocation which holds every column. Elements are accessed as tuples of references.
+//
+// Allocator, GrowthPolicy and SizeType mean the same as for SmallVec. The allocator's
+// value_type is std::byte, it is rebound to allocate the combined block in units
+// aligned for every column, and to construct elements of each column.
+//
+// The heap switching mirrors SmallVec::grow (capacity never drops below N, shrinking
+// returns to inline storage), but can't reuse it: SmallVec moves one buffer of T,
+// here a tuple of inline arrays and one block carved into columns move at once.
+// Carving the block takes reinterpret_cast, which is why SmallSoAVec isn't constexpr
+template <std::size_t N, typename Allocator, typename GrowthPolicy, typename SizeType, typename... Ts>
+class BasicSmallSoAVec {
+  static_assert(N > 0, "SmallSoAVec needs inline capacity");
+  static_assert(sizeof...(Ts) > 0, "SmallSoAVec needs at least one column");
+  static_assert(std::is_unsigned_v<SizeType>, "SizeType must be an unsigned integer");
+  static_assert(N <= std::numeric_limits<SizeType>::max(), "inline capacity does not fit into SizeType");
+  static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, std::byte>,
+                "Allocator::value_type must be std::byte");
+
+  using Indices = std::index_sequence_for<Ts...>;
+
+  template <std::size_t I>
+  using ColumnType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+  // members are left uninitialized, only `len` elements are ever alive
+  template <typename T>
+  union InlineColumn {
+    InlineColumn() noexcept {}
+    ~InlineColumn() {}
+
+    T stack[N];
+  };
+
+  static constexpr std::size_t alignment = std::max({alignof(Ts)...});
+  static constexpr std::size_t elementSize = (sizeof(Ts) + ...);
+
+  // unit of the heap block, aligned for every column
+  struct alignas(alignment) Block {
+    std::byte bytes[alignment];
+  };
+
+  using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+  using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+  template <typename T>
+  using ColumnAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+  static_assert(std::is_same_v<typename BlockTraits::pointer, Block *>, "Allocator must hand out raw pointers");
+
+  // first, for the reason given at SmallVec::alloc
+  [[no_unique_address]] BlockAllocator alloc;
+  std::tuple<InlineColumn<Ts>...> inlineColumns;
+  // the current buffer of every column, the first one also starts the heap allocation
+  std::tuple<Ts *...> columns;
+  SizeType cap;
+  SizeType len;
+
+  static constexpr bool isNothrowMoveAssignable = (BlockTraits::propagate_on_container_move_assignment::value
+                                                   || BlockTraits::is_always_equal::value)
+      && (std::is_nothrow_move_constructible_v<Ts> && ...);
+
+  template <bool Const>
+  class Iterator;
+
+public:
+  using value_type = std::tuple<Ts...>;
+  using reference = std::tuple<Ts &...>;
+  using const_reference = std::tuple<const Ts &...>;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  static constexpr auto inlineCapacity = N;
+
+  BasicSmallSoAVec() noexcept(noexcept(Allocator())) : alloc(), cap(N), len(0) {
+    pointAtInline();
+  }
+
+  explicit BasicSmallSoAVec(const Allocator &alloc) noexcept : alloc(alloc), cap(N), len(0) {
+    pointAtInline();
+  }
+
+  BasicSmallSoAVec(const BasicSmallSoAVec &rhs)
+      : BasicSmallSoAVec(std::allocator_traits<Allocator>::select_on_container_copy_construction(rhs.getAllocator())) {
+    extendCopying(rhs);
+  }
+
+  BasicSmallSoAVec(BasicSmallSoAVec &&rhs) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...))
+      : alloc(std::move(rhs.alloc)), cap(N), len(0) {
+    pointAtInline();
+    steal(rhs);
+  }
+
+  BasicSmallSoAVec &operator=(const BasicSmallSoAVec &rhs) {
+    if (this == &rhs)
+      return *this;
+    if constexpr (BlockTraits::propagate_on_container_copy_assignment::value) {
+      // memory from the old allocator can't be kept
+      if (alloc != rhs.alloc)
+        dispose();
+      alloc = rhs.alloc;
+    }
+    clear();
+    extendCopying(rhs);
+    return *this;
+  }
+
+  BasicSmallSoAVec &operator=(BasicSmallSoAVec &&rhs) noexcept(isNothrowMoveAssignable) {
+    if (this == &rhs)
+      return *this;
+    dispose();
+    if constexpr (BlockTraits::propagate_on_container_move_assignment::value) {
+      alloc = std::move(rhs.alloc);
+    } else if (alloc != rhs.alloc) {
+      // the block can't be adopted, move elements one by one
+      reserveExact(rhs.len);
+      for (std::size_t i = 0; i < rhs.len; i++)
+        std::apply([&](Ts &...values) { emplaceBackUnchecked(std::move(values)...); }, rhs[i]);
+      rhs.dispose();
+      return *this;
+    }
+    steal(rhs);
+    return *this;
+  }
+
+  ~BasicSmallSoAVec() {
+    dispose();
+  }
+
+  [[nodiscard]] Allocator getAllocator() const { return Allocator(alloc); }
+
+  [[nodiscard]] static constexpr std::size_t maxSize() {
+    return std::min<std::size_t>(std::numeric_limits<SizeType>::max(),
+                                 std::numeric_limits<std::ptrdiff_t>::max() / (elementSize + alignment));
+  }
+
+  [[nodiscard]] bool onHeap() const { return cap > N; }
+  [[nodiscard]] bool onStack() const { return !onHeap(); }
+
+  [[nodiscard]] std::size_t size() const { return len; }
+
+  [[nodiscard]] bool empty() const { return len == 0; }
+
+  [[nodiscard]] std::size_t capacity() const { return cap; }
+
+  // the live elements of column I
+  template <std::size_t I>
+  std::span<ColumnType<I>> column() {
+    return {std::get<I>(columns), len};
+  }
+
+  template <std::size_t I>
+  std::span<const ColumnType<I>> column() const {
+    return {std::get<I>(columns), len};
+  }
+
+  // like SmallVec::grow, capacity never drops below N and all columns move at once
+  void grow(std::size_t newSize) {
+    assert(newSize >= len);
+    if (newSize > maxSize())
+      throw std::length_error("SmallSoAVec capacity exceeds maxSize()");
+    if (newSize <= N) {
+      if (onStack())
+        return;
+      auto heapColumns = columns;
+      pointAtInline();
+      relocateColumns(heapColumns, columns);
+      deallocate(heapColumns, cap);
+      cap = N;
+    } else if (newSize != cap) {
+      auto newColumns = allocate(newSize);
+      relocateColumns(columns, newColumns);
+      if (onHeap())
+        deallocate(columns, cap);
+      columns = newColumns;
+      cap = static_cast<SizeType>(newSize);
+    }
+  }
+
+  void reserve(std::size_t additional) {
+    if (capacity() - size() >= additional)
+      return;
+    if (additional > maxSize() - len)
+      throw std::length_error("SmallSoAVec size exceeds maxSize()");
+    std::size_t required = len + additional;
+    auto newSize = GrowthPolicy::next(cap, required, elementSize);
+    assert(newSize >= required);
+    grow(std::min(newSize, maxSize()));
+  }
+
+  void reserveExact(std::size_t additional) {
+    if (capacity() - size() >= additional)
+      return;
+    if (additional > maxSize() - len)
+      throw std::length_error("SmallSoAVec size exceeds maxSize()");
+    grow(len + additional);
+  }
+
+  void shrink() {
+    if (onHeap())
+      grow(len);
+  }
+
+  // takes one value per column
+  template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts))
+  void push(Us &&...values) {
+    emplaceBack(std::forward<Us>(values)...);
+  }
+
+  // builds the element of every column from the corresponding argument
+  template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts))
+  reference emplaceBack(Us &&...values) {
+    if (len == cap) [[unlikely]] {
+      // values may refer to our own elements, so build them before they are relocated
+      std::tuple<Ts...> built(std::forward<Us>(values)...);
+      reserve(1);
+      return std::apply([&](Ts &...items) -> reference { return emplaceBackUnchecked(std::move(items)...); }, built);
+    }
+    return emplaceBackUnchecked(std::forward<Us>(values)...);
+  }
+
+  // expects spare capacity, e.g. after `reserve`
+  template <typename... Us>
+    requires(sizeof...(Us) == sizeof...(Ts))
+  reference emplaceBackUnchecked(Us &&...values) {
+    assert(len < cap);
+    constructAt(Indices{}, len, std::forward<Us>(values)...);
+    return (*this)[len++];
+  }
+
+  void pop() {
+    if (len > 0)
+      truncate(len - 1);
+  }
+
+  void clear() noexcept {
+    truncate(0);
+  }
+
+  // new elements are value-initialized
+  void resize(std::size_t n) {
+    if (n <= len)
+      return truncate(n);
+    reserve(n - len);
+    while (len < n)
+      emplaceBackUnchecked(Ts()...);
+  }
+
+  // O(1) removal of the element at `index`, which is replaced by the last element
+  void swapRemove(std::size_t index) {
+    assert(index < len);
+    if (index != len - 1)
+      (*this)[index] = std::apply([](Ts &...items) { return std::forward_as_tuple(std::move(items)...); }, (*this)[len - 1]);
+    pop();
+  }
+
+  reference operator[](std::size_t index) {
+    return std::apply([&](Ts *...column) { return reference(column[index]...); }, columns);
+  }
+
+  const_reference operator[](std::size_t index) const {
+    return std::apply([&](Ts *...column) { return const_reference(column[index]...); }, columns);
+  }
+
+  reference back() {
+    return (*this)[len - 1];
+  }
+
+  const_reference back() const {
+    return (*this)[len - 1];
+  }
+
+  iterator begin() {
+    return iterator(columns, 0);
+  }
+
+  const_iterator begin() const {
+    return const_iterator(columns, 0);
+  }
+
+  iterator end() {
+    return iterator(columns, len);
+  }
+
+  const_iterator end() const {
+    return const_iterator(columns, len);
+  }
+
+private:
+  // A proxy iterator: dereferencing yields a tuple of references into the columns.
+  // Before C++23 gave std::tuple a common reference with tuple references, such
+  // iterators aren't std::input_iterators, so the concept is only claimed from then on.
+  // They still provide the full random access interface
+  template <bool Const>
+  class Iterator {
+    std::tuple<Ts *...> columns;
+    std::ptrdiff_t index = 0;
+
+    friend class BasicSmallSoAVec;
+    friend class Iterator<!Const>;
+
+    Iterator(const std::tuple<Ts *...> &columns, std::size_t index)
+        : columns(columns),
+          index(static_cast<std::ptrdiff_t>(index)) {}
+
+  public:
+    using value_type = std::tuple<Ts...>;
+    using reference = std::conditional_t<Const, std::tuple<const Ts &...>, std::tuple<Ts &...>>;
+    using difference_type = std::ptrdiff_t;
+#ifdef __cpp_lib_ranges_zip
+    using iterator_concept = std::random_access_iterator_tag;
+#endif
+    using iterator_category = std::input_iterator_tag;
+
+    Iterator() = default;
+
+    // iterator to const_iterator. A template, so that it never counts as Iterator<false>'s copy constructor
+    template <bool RhsConst>
+      requires(Const && !RhsConst)
+    Iterator(const Iterator<RhsConst> &rhs)
+        : columns(rhs.columns), index(rhs.index) {}
+
+    reference operator*() const {
+      return std::apply([&](Ts *...column) { return reference(column[index]...); }, columns);
+    }
+
+    reference operator[](difference_type offset) const {
+      return *(*this + offset);
+    }
+
+    Iterator &operator++() {
+      ++index;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy = *this;
+      ++index;
+      return copy;
+    }
+
+    Iterator &operator--() {
+      --index;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      auto copy = *this;
+      --index;
+      return copy;
+    }
+
+    Iterator &operator+=(difference_type offset) {
+      index += offset;
+      return *this;
+    }
+
+    Iterator &operator-=(difference_type offset) {
+      index -= offset;
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type offset) {
+      return it += offset;
+    }
+
+    friend Iterator operator+(difference_type offset, Iterator it) {
+      return it += offset;
+    }
+
+    friend Iterator operator-(Iterator it, difference_type offset) {
+      return it -= offset;
+    }
+
+    friend difference_type operator-(const Iterator &lhs, const Iterator &rhs) {
+      return lhs.index - rhs.index;
+    }
+
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs) {
+      return lhs.index == rhs.index;
+    }
+
+    friend auto operator<=>(const Iterator &lhs, const Iterator &rhs) {
+      return lhs.index <=> rhs.index;
+    }
+  };
+
+  void pointAtInline() noexcept {
+    columns = std::apply([](InlineColumn<Ts> &...column) { return std::tuple<Ts *...>(column.stack...); }, inlineColumns);
+  }
+
+  // byte offsets of every column within a heap block of `capacity` elements, and its total size
+  static std::pair<std::array<std::size_t, sizeof...(Ts)>, std::size_t> heapLayout(std::size_t capacity) {
+    std::array<std::size_t, sizeof...(Ts)> offsets{};
+    std::size_t sizes[] = {sizeof(Ts)...};
+    std::size_t alignments[] = {alignof(Ts)...};
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < sizeof...(Ts); i++) {
+      bytes = (bytes + alignments[i] - 1) / alignments[i] * alignments[i];
+      offsets[i] = bytes;
+      bytes += capacity * sizes[i];
+    }
+    return {offsets, bytes};
+  }
+
+  static std::size_t blockCount(std::size_t capacity) {
+    return (heapLayout(capacity).second + alignment - 1) / alignment;
+  }
+
+  std::tuple<Ts *...> allocate(std::size_t capacity) {
+    auto offsets = heapLayout(capacity).first;
+    auto *block = reinterpret_cast<std::byte *>(BlockTraits::allocate(alloc, blockCount(capacity)));
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return std::tuple<Ts *...>(reinterpret_cast<Ts *>(block + offsets[Is])...);
+    }(Indices{});
+  }
+
+  void deallocate(const std::tuple<Ts *...> &heapColumns, std::size_t capacity) noexcept {
+    BlockTraits::deallocate(alloc, reinterpret_cast<Block *>(std::get<0>(heapColumns)), blockCount(capacity));
+  }
+
+  // moves the live elements of every column into uninitialized `to` and ends their lifetime in `from`
+  void relocateColumns(const std::tuple<Ts *...> &from, const std::tuple<Ts *...> &to) {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (relocateColumn(std::get<Is>(from), std::get<Is>(to)), ...);
+    }(Indices{});
+  }
+
+  template <typename T>
+  void relocateColumn(T *from, T *to) {
+    ColumnAllocator<T> columnAlloc(alloc);
+    detail::relocate(columnAlloc, from, from + len, to);
+  }
+
+  template <typename T, typename U>
+  void constructOne(T *slot, U &&value) {
+    ColumnAllocator<T> columnAlloc(alloc);
+    std::allocator_traits<ColumnAllocator<T>>::construct(columnAlloc, slot, std::forward<U>(value));
+  }
+
+  template <typename T>
+  void destroyColumn(T *first, T *last) noexcept {
+    ColumnAllocator<T> columnAlloc(alloc);
+    for (; first != last; ++first)
+      std::allocator_traits<ColumnAllocator<T>>::destroy(columnAlloc, first);
+  }
+
+  // constructs the element at `index` in every column, or none of them if one throws
+  template <std::size_t... Is, typename... Us>
+  void constructAt(std::index_sequence<Is...>, std::size_t index, Us &&...values) {
+    std::size_t constructed = 0;
+    try {
+      ((constructOne(std::get<Is>(columns) + index, std::forward<Us>(values)), ++constructed), ...);
+    } catch (...) {
+      ((Is < constructed ? destroyColumn(std::get<Is>(columns) + index, std::get<Is>(columns) + index + 1) : void()), ...);
+      throw;
+    }
+  }
+
+  void extendCopying(const BasicSmallSoAVec &rhs) {
+    reserveExact(rhs.len);
+    for (std::size_t i = 0; i < rhs.len; i++)
+      std::apply([&](const Ts &...values) { emplaceBackUnchecked(values...); }, rhs[i]);
+  }
+
+  // destroys elements past `n`
+  void truncate(std::size_t n) noexcept {
+    if (n >= len)
+      return;
+    std::apply([&](Ts *...column) { (destroyColumn(column + n, column + len), ...); }, columns);
+    len = static_cast<SizeType>(n);
+  }
+
+  // destroys all elements and returns to the empty inline state
+  void dispose() noexcept {
+    clear();
+    if (onHeap())
+      deallocate(columns, cap);
+    cap = N;
+    pointAtInline();
+  }
+
+  // expects `this` to be empty and inline, leaves `rhs` empty and inline
+  void steal(BasicSmallSoAVec &rhs) {
+    if (rhs.onHeap()) {
+      columns = rhs.columns;
+      cap = rhs.cap;
+      len = rhs.len;
+      rhs.cap = N;
+      rhs.len = 0;
+      rhs.pointAtInline();
+      return;
+    }
+    len = rhs.len;
+    rhs.relocateColumns(rhs.columns, columns);
+    rhs.len = 0;
+  }
+};
+
+template <std::size_t N, typename... Ts>
+using SmallSoAVec = BasicSmallSoAVec<N, std::allocator<std::byte>, PowerOfTwoGrowth, std::size_t, Ts...>;
+}// namespace smallvec
@@ -0,0 +1,293 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <charconv>
+#include <compare>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <version>
+
+#ifdef __cpp_lib_format
+#include <format>
+#endif
+
+#include "SmallVec.hpp"
+
+namespace smallvec {
+// Null-terminated string with inline room for N characters, stored as a
+// SmallVec<char, N + 1> whose last element is always '\0'. Unlike std::string,
+// whose inline buffer holds 15 characters, N is up to you, so e.g. log lines of a
+// SmallString<256> never allocate
+template <std::size_t N>
+class SmallString {
+  SmallVec<char, N + 1> chars;
+
+public:
+  using value_type = char;
+  using iterator = char *;
+  using const_iterator = const char *;
+
+  static constexpr auto inlineCapacity = N;
+
+  constexpr SmallString() {
+    chars.pushUnchecked('\0');
+  }
+
+  constexpr SmallString(std::string_view str) : SmallString() {
+    append(str);
+  }
+
+  constexpr SmallString(const char *str) : SmallString(std::string_view(str)) {}
+
+  constexpr SmallString(std::size_t count, char ch) : SmallString() {
+    append(count, ch);
+  }
+
+  constexpr SmallString(const SmallString &) = default;
+  constexpr SmallString &operator=(const SmallString &) = default;
+
+  // the source is left empty, with its terminator restored
+  constexpr SmallString(SmallString &&rhs) noexcept : chars(std::move(rhs.chars)) {
+    rhs.clear();
+  }
+
+  constexpr SmallString &operator=(SmallString &&rhs) noexcept {
+    if (this != &rhs) {
+      chars = std::move(rhs.chars);
+      rhs.clear();
+    }
+    return *this;
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const { return chars.size() - 1; }
+
+  [[nodiscard]] constexpr bool empty() const { return size() == 0; }
+
+  // characters which fit without allocating, excluding the terminator
+  [[nodiscard]] constexpr std::size_t capacity() const { return chars.capacity() - 1; }
+
+  [[nodiscard]] constexpr bool onHeap() const { return chars.onHeap(); }
+  [[nodiscard]] constexpr bool onStack() const { return chars.onStack(); }
+
+  constexpr char *data() { return chars.data(); }
+
+  constexpr const char *data() const { return chars.data(); }
+
+  constexpr const char *c_str() const { return chars.data(); }
+
+  constexpr std::string_view view() const { return {data(), size()}; }
+
+  constexpr operator std::string_view() const { return view(); }
+
+  constexpr void reserve(std::size_t additional) {
+    chars.reserve(additional);
+  }
+
+  constexpr void shrink() {
+    chars.shrink();
+  }
+
+  constexpr void clear() noexcept {
+    chars.clear();
+    chars.pushUnchecked('\0');
+  }
+
+  constexpr void push(char ch) {
+    chars.back() = ch;
+    chars.push('\0');
+  }
+
+  // for std::back_inserter, e.g. as the output of fmt::format_to
+  constexpr void push_back(char ch) {
+    push(ch);
+  }
+
+  constexpr void pop() {
+    if (!empty())
+      resize(size() - 1);
+  }
+
+  // Grows the string by `count` characters and returns a pointer to the first one, so
+  // that they can be written in place. They are left indeterminate, only the terminator is set
+  constexpr char *appendUninitialized(std::size_t count) {
+    auto oldSize = size();
+    chars.resizeForOverwrite(oldSize + count + 1);
+    chars[oldSize + count] = '\0';
+    return chars.data() + oldSize;
+  }
+
+  constexpr SmallString &append(std::string_view str) {
+    if (capacity() - size() < str.size()) {
+      if (std::is_constant_evaluated()) {
+        // unrelated pointers can't be compared during constant evaluation, copy instead
+        std::string copy(str);
+        reserve(copy.size());
+        std::char_traits<char>::copy(appendUninitialized(copy.size()), copy.data(), copy.size());
+        return *this;
+      }
+      // `str` may point into this string, which growing would invalidate
+      bool aliases = !std::less<>()(str.data(), data()) && std::less<>()(str.data(), data() + size());
+      auto offset = aliases ? static_cast<std::size_t>(str.data() - data()) : 0;
+      reserve(str.size());
+      if (aliases)
+        str = std::string_view(data() + offset, str.size());
+    }
+    std::char_traits<char>::copy(appendUninitialized(str.size()), str.data(), str.size());
+    return *this;
+  }
+
+  constexpr SmallString &append(std::size_t count, char ch) {
+    std::char_traits<char>::assign(appendUninitialized(count), count, ch);
+    return *this;
+  }
+
+  // appends the shortest decimal representation of `value` with std::to_chars
+  template <typename Number>
+    requires std::is_arithmetic_v<Number>
+  SmallString &appendNumber(Number value) {
+    // enough for any integer and the shortest round trip of a double. Converted into a
+    // local buffer, so only the digits written have to fit into the spare capacity
+    constexpr std::size_t maxLength = 32;
+    char buffer[maxLength];
+    auto [last, error] = std::to_chars(buffer, buffer + maxLength, value);
+    assert(error == std::errc());
+    return append(std::string_view(buffer, static_cast<std::size_t>(last - buffer)));
+  }
+
+  // Appends printf-style output, formatted straight into the spare capacity first,
+  // then once more after growing if it didn't fit
+  __attribute__((format(printf, 2, 3))) SmallString &appendPrintf(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vappendPrintf(format, args);
+    va_end(args);
+    return *this;
+  }
+
+  SmallString &vappendPrintf(const char *format, va_list args) {
+    va_list retry;
+    va_copy(retry, args);
+    auto oldSize = size();
+    // the spare capacity includes the terminator slot, which vsnprintf overwrites with '\0'
+    auto spare = capacity() - oldSize + 1;
+    auto length = std::vsnprintf(data() + oldSize, spare, format, args);
+    if (length < 0) {
+      va_end(retry);
+      data()[oldSize] = '\0';
+      throw std::runtime_error("SmallString::appendPrintf: invalid format");
+    }
+    auto written = static_cast<std::size_t>(length);
+    if (written >= spare) {
+      reserve(written);
+      std::vsnprintf(data() + oldSize, written + 1, format, retry);
+    }
+    va_end(retry);
+    chars.resizeForOverwrite(oldSize + written + 1);
+    return *this;
+  }
+
+#ifdef __cpp_lib_format
+  // like appendPrintf, first formats into the spare capacity with std::format_to_n.
+  // Only available where the standard library ships <format> (e.g. GCC 13, Clang 17),
+  // use appendPrintf or appendNumber elsewhere
+  template <typename... Args>
+  SmallString &formatTo(std::format_string<const Args &...> format, const Args &...args) {
+    auto oldSize = size();
+    auto spare = capacity() - oldSize;
+    auto result = std::format_to_n(data() + oldSize, spare, format, args...);
+    auto written = static_cast<std::size_t>(result.size);
+    if (written > spare) {
+      reserve(written);
+      std::format_to_n(data() + oldSize, written, format, args...);
+    }
+    chars.resizeForOverwrite(oldSize + written + 1);
+    chars.back() = '\0';
+    return *this;
+  }
+#endif
+
+  constexpr void resize(std::size_t n, char ch = '\0') {
+    if (n <= size()) {
+      chars.resize(n + 1);
+      chars.back() = '\0';
+    } else {
+      append(n - size(), ch);
+    }
+  }
+
+  // new characters are left indeterminate
+  constexpr void resizeForOverwrite(std::size_t n) {
+    if (n <= size()) {
+      resize(n);
+    } else {
+      appendUninitialized(n - size());
+    }
+  }
+
+  constexpr SmallString &operator+=(std::string_view str) {
+    return append(str);
+  }
+
+  constexpr SmallString &operator+=(char ch) {
+    push(ch);
+    return *this;
+  }
+
+  constexpr char &operator[](std::size_t index) {
+    return chars[index];
+  }
+
+  constexpr const char &operator[](std::size_t index) const {
+    return chars[index];
+  }
+
+  constexpr char &back() {
+    return chars[size() - 1];
+  }
+
+  constexpr const char &back() const {
+    return chars[size() - 1];
+  }
+
+  constexpr iterator begin() {
+    return data();
+  }
+
+  constexpr const_iterator begin() const {
+    return data();
+  }
+
+  constexpr iterator end() {
+    return data() + size();
+  }
+
+  constexpr const_iterator end() const {
+    return data() + size();
+  }
+
+  friend constexpr bool operator==(const SmallString &lhs, std::string_view rhs) {
+    return lhs.view() == rhs;
+  }
+
+  friend constexpr std::strong_ordering operator<=>(const SmallString &lhs, std::string_view rhs) {
+    return lhs.view() <=> rhs;
+  }
+};
+}// namespace smallvec
+
+template <std::size_t N>
+struct std::hash<smallvec::SmallString<N>> {
+  std::size_t operator()(const smallvec::SmallString<N> &str) const noexcept {
+    return std::hash<std::string_view>()(str.view());
+  }
+};
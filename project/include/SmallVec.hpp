@@ -6,236 +6,1129 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "SmallVecSimd.hpp"
+
+#ifdef SMALLVEC_ENABLE_STATS
+#include "SmallVecStats.hpp"
+#endif
+
 namespace smallvec {
-template <typename T, std::size_t N>
-class SmallVec {
+// Types for which moving an object to a new address and dropping the old one
+// is equivalent to copying its bytes. Specialize for your own types to opt-in.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+constexpr bool isTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+// Types for which operator== is equivalent to comparing their bytes, so that whole
+// vectors compare with memcmp. Specialize for your own types to opt-in.
+template <typename T>
+struct IsTriviallyEqualityComparable : std::bool_constant<std::is_integral_v<T> || std::is_pointer_v<T>> {};
+
+template <typename T>
+constexpr bool isTriviallyEqualityComparable = IsTriviallyEqualityComparable<T>::value;
+
+// Mirrors C++23 std::allocation_result
+template <typename Pointer>
+struct AllocationResult {
+  Pointer ptr;
+  std::size_t count;
+};
+
+// Allocators which may hand out more elements than requested
+template <typename Allocator>
+concept AllocatesAtLeast = requires(Allocator &alloc, std::size_t n) {
+  { alloc.allocateAtLeast(n) } -> std::same_as<AllocationResult<typename std::allocator_traits<Allocator>::pointer>>;
+};
+
+// Allocators which may resize a block in place, moving its bytes otherwise
+template <typename Allocator>
+concept Reallocates = AllocatesAtLeast<Allocator>
+    && requires(Allocator &alloc, typename std::allocator_traits<Allocator>::pointer ptr, std::size_t n) {
+  { alloc.reallocate(ptr, n, n) } -> std::same_as<AllocationResult<typename std::allocator_traits<Allocator>::pointer>>;
+};
+
+// Growth policies decide the new capacity once `required` elements no longer fit
+// into `capacity`. The result must be at least `required`.
+
+// Default, rounds up to the next power of two
+struct PowerOfTwoGrowth {
+  static constexpr std::size_t next(std::size_t, std::size_t required, std::size_t) {
+    return std::bit_ceil(required);
+  }
+};
+
+// Multiplies the capacity by Numerator / Denominator, e.g. 1.5x by default
+template <std::size_t Numerator = 3, std::size_t Denominator = 2>
+struct FactorGrowth {
+  static_assert(Numerator > Denominator, "growth factor must be greater than one");
+
+  static constexpr std::size_t next(std::size_t capacity, std::size_t required, std::size_t) {
+    return std::max(required, capacity * Numerator / Denominator);
+  }
+};
+
+// Rounds up to a multiple of Step elements. Not amortized, trades reallocations for footprint
+template <std::size_t Step>
+struct FixedStepGrowth {
+  static_assert(Step > 0);
+
+  static constexpr std::size_t next(std::size_t, std::size_t required, std::size_t) {
+    return (required + Step - 1) / Step * Step;
+  }
+};
+
+// Rounds the allocation up to the size classes of jemalloc-like allocators
+// (16 byte quantum, four classes per power of two), so the slack they hand out is used
+struct SizeClassGrowth {
+  static constexpr std::size_t next(std::size_t, std::size_t required, std::size_t elementSize) {
+    auto bytes = std::max<std::size_t>(required * elementSize, 16);
+    auto delta = std::max<std::size_t>(std::bit_floor(bytes - 1) / 4, 16);
+    auto rounded = (bytes + delta - 1) / delta * delta;
+    return rounded / elementSize;
+  }
+};
+
+// Layouts of the SmallVec object
+
+// Default, the heap pointer shares memory with the inline buffer and data() branches on the capacity
+struct UnionLayout {};
+
+// Additionally stores a pointer to the current buffer (like llvm::SmallVector), so that
+// data() is a plain load, at the cost of one more pointer per object
+struct PointerLayout {};
+
+namespace detail {
+// Moves [first, last) into uninitialized `dest` and ends the lifetime of the source,
+// constructing and destroying through `alloc`, whose value_type is T.
+// Bytes can't be copied during constant evaluation, there every element is moved
+template <typename Allocator, typename T>
+constexpr void relocate(Allocator &alloc, T *first, T *last, T *dest) noexcept(std::is_nothrow_move_constructible_v<T>) {
+  if constexpr (isTriviallyRelocatable<T>) {
+    if (!std::is_constant_evaluated()) {
+      if (first != last)
+        std::memcpy(static_cast<void *>(dest), first, (last - first) * sizeof(T));
+      return;
+    }
+  }
+  using Traits = std::allocator_traits<Allocator>;
+  for (; first != last; ++first, ++dest) {
+    Traits::construct(alloc, dest, std::move(*first));
+    Traits::destroy(alloc, first);
+  }
+}
+
+// Members of SmallVec and StaticVec which only need the elements, written once so
+// that both expose the same API. Derived provides data(), size() and truncate(n)
+template <typename Derived, typename T>
+class VecBase {
+  constexpr Derived &self() { return static_cast<Derived &>(*this); }
+  constexpr const Derived &self() const { return static_cast<const Derived &>(*this); }
+
+public:
+  constexpr void pop() {
+    if (self().size() > 0)
+      self().truncate(self().size() - 1);
+  }
+
+  // removes the last element and returns it, the vector must not be empty
+  constexpr T popBack() {
+    assert(self().size() > 0);
+    T result(std::move(back()));
+    pop();
+    return result;
+  }
+
+  // destroys all elements, but keeps the capacity
+  constexpr void clear() noexcept {
+    self().truncate(0);
+  }
+
+  // O(1) erase, which fills the hole with the last element
+  constexpr T *eraseUnordered(const T *pos) {
+    auto index = static_cast<std::size_t>(pos - begin());
+    assert(index < self().size());
+    if (index != self().size() - 1)
+      begin()[index] = std::move(back());
+    pop();
+    return begin() + index;
+  }
+
+  // O(1) removal of the element at `index`, which is replaced by the last element
+  constexpr T swapRemove(std::size_t index) {
+    assert(index < self().size());
+    T result(std::move(begin()[index]));
+    eraseUnordered(begin() + index);
+    return result;
+  }
+
+  // Keeps only the elements satisfying `pred`, compacting in place in a single pass.
+  // Returns the number of removed elements
+  template <typename Pred>
+  constexpr std::size_t retain(Pred pred) {
+    auto newEnd = std::remove_if(begin(), end(), [&](T &item) { return !std::invoke(pred, std::as_const(item)); });
+    auto removed = static_cast<std::size_t>(end() - newEnd);
+    self().truncate(self().size() - removed);
+    return removed;
+  }
+
+  // Linear searches, vectorized for arithmetic T (see SmallVecSimd.hpp)
+  constexpr T *find(const T &value) {
+    return begin() + findIndex(value);
+  }
+
+  constexpr const T *find(const T &value) const {
+    return begin() + findIndex(value);
+  }
+
+  [[nodiscard]] constexpr bool contains(const T &value) const {
+    return findIndex(value) != self().size();
+  }
+
+  [[nodiscard]] constexpr std::size_t count(const T &value) const {
+    if constexpr (simd::Vectorizable<T>) {
+      if (!std::is_constant_evaluated())
+        return simd::count(begin(), self().size(), value);
+    }
+    return static_cast<std::size_t>(std::count(begin(), end(), value));
+  }
+
+  constexpr T &back() {
+    return begin()[self().size() - 1];
+  }
+
+  constexpr const T &back() const {
+    return begin()[self().size() - 1];
+  }
+
+  constexpr T &operator[](std::size_t index) {
+    return begin()[index];
+  }
+
+  constexpr const T &operator[](std::size_t index) const {
+    return begin()[index];
+  }
+
+  constexpr T *begin() {
+    return self().data();
+  }
+
+  constexpr const T *begin() const {
+    return self().data();
+  }
+
+  constexpr T *end() {
+    return self().data() + self().size();
+  }
+
+  constexpr const T *end() const {
+    return self().data() + self().size();
+  }
+
+  constexpr std::span<T> asSpan() {
+    return {begin(), self().size()};
+  }
+
+  constexpr std::span<const T> asSpan() const {
+    return {begin(), self().size()};
+  }
+
+  // the object representation of the elements, e.g. to send them over a socket
+  std::span<const std::byte> asBytes() const
+    requires std::is_trivially_copyable_v<T>
+  {
+    return std::as_bytes(asSpan());
+  }
+
+  std::span<std::byte> asWritableBytes()
+    requires std::is_trivially_copyable_v<T>
+  {
+    return std::as_writable_bytes(asSpan());
+  }
+
+  friend constexpr bool operator==(const Derived &lhs, const Derived &rhs) {
+    auto size = lhs.size();
+    if (size != rhs.size())
+      return false;
+    if constexpr (isTriviallyEqualityComparable<T>) {
+      if (!std::is_constant_evaluated())
+        return size == 0 || std::memcmp(lhs.begin(), rhs.begin(), size * sizeof(T)) == 0;
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+private:
+  constexpr std::size_t findIndex(const T &value) const {
+    if constexpr (simd::Vectorizable<T>) {
+      if (!std::is_constant_evaluated())
+        return simd::find(begin(), self().size(), value);
+    }
+    return static_cast<std::size_t>(std::find(begin(), end(), value) - begin());
+  }
+};
+}// namespace detail
+
+// SizeType stores the length and capacity, narrower types shrink sizeof(SmallVec)
+template <typename T,
+          std::size_t N,
+          typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = PowerOfTwoGrowth,
+          typename SizeType = std::size_t,
+          typename Layout = UnionLayout>
+class SmallVec : public detail::VecBase<SmallVec<T, N, Allocator, GrowthPolicy, SizeType, Layout>, T> {
+  static_assert(std::is_unsigned_v<SizeType>, "SizeType must be an unsigned integer");
+  static_assert(N <= std::numeric_limits<SizeType>::max(), "inline capacity does not fit into SizeType");
+  static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, T>,
+                "Allocator::value_type must be T");
+
+  static_assert(std::is_same_v<Layout, UnionLayout> || std::is_same_v<Layout, PointerLayout>);
+
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  static constexpr bool storesDataPointer = std::is_same_v<Layout, PointerLayout>;
+
+  struct NoDataPointer {
+    constexpr explicit NoDataPointer(T *) noexcept {}
+  };
+
+  using Base = detail::VecBase<SmallVec, T>;
+  friend Base;
+
 public:
   using iterator = T *;
   using const_iterator = const T *;
+  using allocator_type = Allocator;
+
+  using Base::back;
+  using Base::begin;
+  using Base::clear;
+  using Base::end;
+  using Base::pop;
 
 private:
+  // Declared first: value-initializing an allocator without a user-provided default
+  // constructor zeroes its storage, which GCC lets spill over the members it overlaps.
+  // Initializing it before them keeps their values
+  [[no_unique_address]] Allocator alloc;
+  struct ActiveStack {};
+
+  // members are left uninitialized, only `len` elements are ever alive
   union SmallVecData {
+    constexpr SmallVecData() noexcept {}
+    // only used during constant evaluation, see `activateStack`
+    constexpr explicit SmallVecData(ActiveStack) : stack() {}
+    constexpr ~SmallVecData() {}
+
     T stack[N];
     T *heap;
   } impl;
-  std::size_t cap;
-  std::size_t len;
+  SizeType cap;
+  SizeType len;
+  // points to impl.stack or impl.heap with PointerLayout, see `syncDataPointer`
+  [[no_unique_address]] std::conditional_t<storesDataPointer, T *, NoDataPointer> ptr{impl.stack};
+
+  static constexpr bool isNothrowMoveAssignable = (AllocTraits::propagate_on_container_move_assignment::value
+                                                   || AllocTraits::is_always_equal::value)
+      && std::is_nothrow_move_constructible_v<T>;
 
 public:
   static constexpr auto inlineCapacity = N;
 
-  SmallVec(const SmallVec &rhs) : cap(N), len(0), impl() {
-    extendCopying(rhs.begin(), rhs.end());
+  constexpr SmallVec(const SmallVec &rhs)
+      : alloc(AllocTraits::select_on_container_copy_construction(rhs.alloc)),
+        impl(),
+        cap(N),
+        len(0) {
+    activateStack();
+    extendCopyingExact(rhs.begin(), rhs.end());
   }
 
-  SmallVec(SmallVec &&rhs) noexcept : cap(N), len(0), impl() {
-    extendConsuming(rhs.begin(), rhs.end());
+  constexpr SmallVec(SmallVec &&rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+      : alloc(std::move(rhs.alloc)),
+        impl(),
+        cap(N),
+        len(0) {
+    activateStack();
+    steal(rhs);
   }
 
-  ~SmallVec() {
-    if (onHeap())
-      delete[] impl.heap;
+  // reuses the current buffer whenever it is large enough
+  constexpr SmallVec &operator=(const SmallVec &rhs) {
+    if (this == &rhs)
+      return *this;
+    if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+      // memory from the old allocator can't be kept
+      if (alloc != rhs.alloc)
+        dispose();
+      alloc = rhs.alloc;
+    }
+    assign(rhs.begin(), rhs.end());
+    return *this;
+  }
+
+  constexpr SmallVec &operator=(SmallVec &&rhs) noexcept(isNothrowMoveAssignable) {
+    if (this == &rhs)
+      return *this;
+    dispose();
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+      alloc = std::move(rhs.alloc);
+    } else if (alloc != rhs.alloc) {
+      // the buffer can't be adopted, move elements one by one
+      extendConsumingExact(rhs.begin(), rhs.end());
+      rhs.dispose();
+      rhs.markMovedFrom();
+      return *this;
+    }
+    steal(rhs);
+    return *this;
   }
 
-  explicit SmallVec() noexcept
-      : impl(),
+  constexpr ~SmallVec() {
+#ifdef SMALLVEC_ENABLE_STATS
+    // an empty moved-from vector would only inflate the empty bucket
+    if (!std::is_constant_evaluated() && !isMovedFrom())
+      stats::of<SmallVec, T>().recordDestruction(len);
+#endif
+    dispose();
+  }
+
+  constexpr explicit SmallVec() noexcept(noexcept(Allocator()))
+      : alloc(),
+        impl(),
         cap(N),
-        len(0) {}
+        len(0) {
+    activateStack();
+  }
+
+  constexpr explicit SmallVec(const Allocator &alloc) noexcept
+      : alloc(alloc),
+        impl(),
+        cap(N),
+        len(0) {
+    activateStack();
+  }
 
   template <std::size_t M>
-  SmallVec(T(&&data)[M])
-      : cap(std::max(M, N)),
-        len(0),
-        impl() {
-    extendConsuming(data, data + M);
+  constexpr SmallVec(T(&&data)[M], const Allocator &alloc = Allocator())
+      : alloc(alloc),
+        impl(),
+        cap(N),
+        len(0) {
+    activateStack();
+    extendConsumingExact(data, data + M);
   }
 
   template <std::size_t M>
-  SmallVec(T (&data)[M])
-      : cap(std::max(M, N)),
-        len(0),
-        impl() {
-    extendCopying(data, data + M);
+  constexpr SmallVec(T (&data)[M], const Allocator &alloc = Allocator())
+      : alloc(alloc),
+        impl(),
+        cap(N),
+        len(0) {
+    activateStack();
+    extendCopyingExact(data, data + M);
   }
 
   template <typename... U>
-  SmallVec(U... tail) noexcept
+    requires(std::is_convertible_v<U, T> && ...)
+  constexpr SmallVec(U... tail)
       : SmallVec({tail...}) {}
 
-  [[nodiscard]] bool onHeap() const { return cap > N; }
-  [[nodiscard]] bool onStack() const { return !onHeap(); }
+  [[nodiscard]] constexpr allocator_type getAllocator() const { return alloc; }
+
+  [[nodiscard]] static constexpr std::size_t maxSize() {
+    return std::min<std::size_t>(std::numeric_limits<SizeType>::max(),
+                                 std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T));
+  }
+
+  [[nodiscard]] constexpr bool onHeap() const { return cap > N; }
+  [[nodiscard]] constexpr bool onStack() const { return !onHeap(); }
 
   constexpr iterator data() {
+    if constexpr (storesDataPointer)
+      return ptr;
     if (onHeap())
       return impl.heap;
     return impl.stack;
   }
 
   constexpr const_iterator data() const {
+    if constexpr (storesDataPointer)
+      return ptr;
     if (onHeap())
       return impl.heap;
     return impl.stack;
   }
 
-  void grow(std::size_t newSize) {
+  constexpr void grow(std::size_t newSize) {
     assert(newSize >= len);
+    if (newSize > maxSize())
+      throw std::length_error("SmallVec capacity exceeds maxSize()");
     if (newSize <= N) {
       // on stack memory already allocated
       if (onStack())
         return;
-      // on heap, copy to stack
-      auto heapPrt = impl.heap;
-      std::swap_ranges(heapPrt, heapPrt + len, std::begin(impl.stack));
-      delete[] heapPrt;
+      // on heap, move to stack
+      auto heapPtr = impl.heap;
+      activateStack();
+      relocate(heapPtr, heapPtr + len, impl.stack);
+      AllocTraits::deallocate(alloc, heapPtr, cap);
+      // inline capacity is always N, which keeps `onHeap() == cap > N`
+      newSize = N;
     } else if (newSize != cap) {
-      T *memory = new T[newSize];
-      std::swap_ranges(data(), data() + len, memory);
+#ifdef SMALLVEC_ENABLE_STATS
+      if (!std::is_constant_evaluated())
+        stats::of<SmallVec, T>().recordGrow(onStack(), len);
+#endif
+      if constexpr (Reallocates<Allocator> && isTriviallyRelocatable<T>) {
+        if (onHeap()) {
+          auto [memory, count] = alloc.reallocate(impl.heap, cap, newSize);
+          impl.heap = memory;
+          cap = static_cast<SizeType>(std::min(count, maxSize()));
+          syncDataPointer();
+          return;
+        }
+      }
+      auto [memory, count] = allocateAtLeast(newSize);
+      relocate(data(), data() + len, memory);
       if (onHeap())
-        delete[] impl.heap;
+        AllocTraits::deallocate(alloc, impl.heap, cap);
       impl.heap = memory;
+      newSize = std::min(count, maxSize());
     }
-    cap = newSize;
+    cap = static_cast<SizeType>(newSize);
+    syncDataPointer();
   }
 
-  void reserve(std::size_t additional) {
-    if (cap - len >= additional)
+  constexpr void reserve(std::size_t additional) {
+    if (capacity() - size() >= additional)
       return;
-    constexpr auto nextPowerOfTwo = [](std::size_t n) {
-      std::size_t result = 1;
-      while (n > result)
-        result <<= 1;
-      return result;
-    };
-    auto newSize = nextPowerOfTwo(len + additional);
-    grow(newSize);
-  }
-
-  void reserveExact(std::size_t additional) {
-    if (cap - len >= additional)
+    if (additional > maxSize() - len)
+      throw std::length_error("SmallVec size exceeds maxSize()");
+    std::size_t required = len + additional;
+    auto newSize = GrowthPolicy::next(cap, required, sizeof(T));
+    assert(newSize >= required);
+    grow(std::min(newSize, maxSize()));
+  }
+
+  constexpr void reserveExact(std::size_t additional) {
+    if (capacity() - size() >= additional)
       return;
-    auto newSize = len + additional;
-    grow(newSize);
+    if (additional > maxSize() - len)
+      throw std::length_error("SmallVec size exceeds maxSize()");
+    grow(len + additional);
+  }
+
+  constexpr void shrink() {
+    shrinkToFit();
   }
 
-  void shrink() {
+  // Shrinks the capacity to max(size(), keepCapacity) with at most one reallocation,
+  // moving back to inline storage when that fits. A non-zero `keepCapacity` lets
+  // pooled vectors keep their buffer instead of bouncing between inline and heap
+  constexpr void shrinkToFit(std::size_t keepCapacity = 0) {
     if (onStack())
       return;
-    if (N >= len) {
-      auto heapPtr = impl.heap;
-      std::swap_ranges(heapPtr, heapPtr + len, impl.stack);
-      delete[] heapPtr;
-      cap = len;
-    } else if (cap > len) {
-      grow(len);
-    }
+    auto target = std::max(size(), keepCapacity);
+    if (target < capacity())
+      grow(target);
+  }
+
+  // Destroys all elements and frees the heap buffer, unless its capacity is at
+  // most `retainCapacity`, so that vectors reused across requests don't reallocate
+  constexpr void releaseMemory(std::size_t retainCapacity = 0) noexcept {
+    if (capacity() <= retainCapacity)
+      clear();
+    else
+      dispose();
   }
 
-  [[nodiscard]] std::size_t size() const { return len; }
+  [[nodiscard]] constexpr std::size_t size() const { return len; }
 
-  [[nodiscard]] std::size_t capacity() const { return cap; }
+  [[nodiscard]] constexpr std::size_t capacity() const { return cap; }
 
-  [[nodiscard]] std::size_t takenSize() const {
+  [[nodiscard]] constexpr std::size_t takenSize() const {
     if (onHeap())
       return sizeof(SmallVec) + (cap + 1) * sizeof(T);
     return sizeof(SmallVec);
   }
 
   template <typename U>
-  void push(U &&value) {
-    if (len == cap)
-      reserve(1);
-    data()[len] = std::forward<U>(value);
+  constexpr void push(U &&value) {
+    emplaceBack(std::forward<U>(value));
+  }
+
+  // expects spare capacity, e.g. after `reserve`
+  template <typename U>
+  constexpr void pushUnchecked(U &&value) {
+    emplaceBackUnchecked(std::forward<U>(value));
+  }
+
+  template <typename... Args>
+  constexpr T &emplaceBack(Args &&...args) {
+    if (len == cap) [[unlikely]]
+      return growAndEmplaceBack(std::forward<Args>(args)...);
+    return emplaceBackUnchecked(std::forward<Args>(args)...);
+  }
+
+  // expects spare capacity, e.g. after `reserve`
+  template <typename... Args>
+  constexpr T &emplaceBackUnchecked(Args &&...args) {
+    assert(len < cap);
+    T *slot = data() + len;
+    AllocTraits::construct(alloc, slot, std::forward<Args>(args)...);
     len++;
+    return *slot;
   }
 
+  // Extends grow the capacity with the growth policy, so that appending in
+  // small chunks stays amortized O(1), the *Exact variants reserve only what is needed
   template <typename Iter>
-  void extendConsuming(Iter begin, Iter end) {
-    auto size = std::distance(begin, end);
-    reserveExact(size);
-    std::swap_ranges(begin, end, data() + len);
-    len += size;
+  constexpr void extendConsuming(Iter begin, Iter end) {
+    extendFrom<false, true>(begin, end);
   }
 
   template <typename Iter>
-  void extendCopying(Iter begin, Iter end) {
-    auto size = std::distance(begin, end);
-    reserveExact(size);
-    std::copy(begin, end, data() + len);
-    len += size;
+  constexpr void extendCopying(Iter begin, Iter end) {
+    extendFrom<false, false>(begin, end);
   }
 
-  std::vector<T> intoVector() && {
-    std::vector<T> result(len);
-    if (onStack())
-      std::swap_ranges(begin(), end(), result.begin());
-    else
-      result = {begin(), end()};
+  template <typename Iter>
+  constexpr void extendConsumingExact(Iter begin, Iter end) {
+    extendFrom<true, true>(begin, end);
+  }
+
+  template <typename Iter>
+  constexpr void extendCopyingExact(Iter begin, Iter end) {
+    extendFrom<true, false>(begin, end);
+  }
+
+  // Appends copies of the range elements (or moves, for e.g. `std::views::as_rvalue`).
+  // Sized ranges reserve once and contiguous ranges of trivially copyable T are
+  // copied bytewise, other ranges are traversed only once
+  template <std::ranges::input_range R>
+  constexpr void appendRange(R &&range) {
+    if constexpr (std::ranges::sized_range<R>) {
+      auto size = static_cast<std::size_t>(std::ranges::size(range));
+      reserve(size);
+      appendReserved(std::ranges::begin(range), std::ranges::end(range), size);
+    } else {
+      for (auto &&item : range)
+        emplaceBack(std::forward<decltype(item)>(item));
+    }
+  }
+
+  // a std::vector can't adopt our buffer, so elements are moved over in one pass
+  template <typename VectorAllocator = std::allocator<T>>
+  constexpr std::vector<T, VectorAllocator> intoVector(const VectorAllocator &vectorAlloc = VectorAllocator()) && {
+    std::vector<T, VectorAllocator> result(vectorAlloc);
+    result.reserve(len);
+    result.insert(result.end(), std::make_move_iterator(begin()), std::make_move_iterator(end()));
+    dispose();
     return result;
   }
 
-  void pop() {
-    if (len > 0)
-      len--;
+  // appends `count` copies of `value`
+  constexpr void append(std::size_t count, const T &value) {
+    if (capacity() - size() >= count) {
+      for (std::size_t i = 0; i < count; i++)
+        emplaceBackUnchecked(value);
+      return;
+    }
+    // value may refer to our own elements
+    T copy(value);
+    reserve(count);
+    append(count, copy);
+  }
+
+  // Replaces the contents, assigning over live elements and allocating only if
+  // the new size exceeds capacity(). [first, last) must not point into this vector
+  template <std::input_iterator Iter>
+  constexpr void assign(Iter first, Iter last) {
+    if constexpr (std::forward_iterator<Iter>) {
+      auto count = static_cast<std::size_t>(std::distance(first, last));
+      if (count > capacity()) {
+        clear();
+        grow(count);
+        appendReserved(first, last, count);
+        return;
+      }
+      auto overwritten = std::min(count, size());
+      auto mid = std::next(first, overwritten);
+      std::copy(first, mid, begin());
+      if (count > size())
+        appendReserved(mid, last, count - size());
+      else
+        truncate(count);
+    } else {
+      auto it = begin();
+      for (; first != last && it != end(); ++first, ++it)
+        *it = *first;
+      truncate(static_cast<std::size_t>(it - begin()));
+      for (; first != last; ++first)
+        emplaceBack(*first);
+    }
+  }
+
+  constexpr void assign(std::size_t count, const T &value) {
+    if (count > capacity()) {
+      // value may refer to our own elements
+      T copy(value);
+      clear();
+      grow(count);
+      append(count, copy);
+      return;
+    }
+    std::fill_n(begin(), std::min(count, size()), value);
+    if (count > size())
+      append(count - size(), value);
+    else
+      truncate(count);
+  }
+
+  // new elements are value-initialized
+  constexpr void resize(std::size_t n) {
+    if (n <= len)
+      return truncate(n);
+    reserve(n - len);
+    while (len < n)
+      emplaceBackUnchecked();
   }
 
-  T &back() {
-    return this[len - 1];
+  constexpr void resize(std::size_t n, const T &value) {
+    if (n <= len)
+      return truncate(n);
+    append(n - len, value);
   }
 
-  const T &back() const {
-    return this[len - 1];
+  // new elements are default-initialized, i.e. left indeterminate for trivial types,
+  // so that they can be written by e.g. `read` without zeroing them first
+  constexpr void resizeForOverwrite(std::size_t n) {
+    if (n <= len)
+      return truncate(n);
+    reserve(n - len);
+    if (std::is_constant_evaluated()) {
+      // constant evaluation has no indeterminate values
+      while (len < n)
+        emplaceBackUnchecked();
+    } else if constexpr (std::is_trivially_default_constructible_v<T>) {
+      len = static_cast<SizeType>(n);
+    } else {
+      for (; len < n; len++)
+        ::new (static_cast<void *>(data() + len)) T;
+    }
   }
 
-  T &operator[](std::size_t index) {
-    return data()[index];
+  // Positional insertion. Trivially relocatable elements are shifted with memmove,
+  // others are appended and rotated into place, which keeps the vector valid on exceptions
+  template <typename... Args>
+  constexpr iterator emplace(const_iterator pos, Args &&...args) {
+    auto index = static_cast<std::size_t>(pos - begin());
+    assert(index <= len);
+    if constexpr (isTriviallyRelocatable<T> && std::is_nothrow_constructible_v<T, Args...>) {
+      // args may refer to our own elements, which growing or opening the gap moves
+      T value(std::forward<Args>(args)...);
+      reserve(1);
+      openGap(index, 1);
+      AllocTraits::construct(alloc, data() + index, std::move(value));
+      len++;
+    } else {
+      emplaceBack(std::forward<Args>(args)...);
+      std::rotate(begin() + index, end() - 1, end());
+    }
+    return begin() + index;
   }
 
-  const T &operator[](std::size_t index) const {
-    return data()[index];
+  constexpr iterator insert(const_iterator pos, const T &value) {
+    return emplace(pos, value);
   }
 
-  iterator begin() {
-    return data();
+  constexpr iterator insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
   }
 
-  const_iterator begin() const {
-    return data();
+  constexpr iterator insert(const_iterator pos, std::size_t count, const T &value) {
+    auto index = static_cast<std::size_t>(pos - begin());
+    assert(index <= len);
+    if constexpr (isTriviallyRelocatable<T> && std::is_nothrow_copy_constructible_v<T>) {
+      // value may refer to our own elements, which growing or opening the gap moves
+      T copy(value);
+      reserve(count);
+      openGap(index, count);
+      for (std::size_t i = 0; i < count; i++)
+        AllocTraits::construct(alloc, data() + index + i, copy);
+      len += static_cast<SizeType>(count);
+    } else {
+      auto oldLen = len;
+      append(count, value);
+      std::rotate(begin() + index, begin() + oldLen, end());
+    }
+    return begin() + index;
   }
 
-  iterator end() {
-    return data() + len;
+  // [first, last) must not point into this vector
+  template <std::input_iterator Iter>
+  constexpr iterator insert(const_iterator pos, Iter first, Iter last) {
+    auto index = static_cast<std::size_t>(pos - begin());
+    assert(index <= len);
+    if constexpr (isBulkCopyable<Iter>) {
+      auto count = static_cast<std::size_t>(last - first);
+      reserve(count);
+      openGap(index, count);
+      if (std::is_constant_evaluated()) {
+        for (std::size_t i = 0; i < count; i++, ++first)
+          AllocTraits::construct(alloc, data() + index + i, *first);
+      } else if (count > 0) {
+        std::memcpy(data() + index, std::to_address(first), count * sizeof(T));
+      }
+      len += static_cast<SizeType>(count);
+    } else {
+      auto oldLen = len;
+      extendCopying(first, last);
+      std::rotate(begin() + index, begin() + oldLen, end());
+    }
+    return begin() + index;
   }
 
-  const_iterator end() const {
-    return data() + len;
+  constexpr iterator erase(const_iterator pos) {
+    return erase(pos, pos + 1);
   }
+
+  constexpr iterator erase(const_iterator first, const_iterator last) {
+    auto index = static_cast<std::size_t>(first - begin());
+    auto count = static_cast<std::size_t>(last - first);
+    assert(index + count <= len);
+    T *from = data() + index;
+    if constexpr (isTriviallyRelocatable<T>) {
+      destroyRange(from, from + count);
+      auto tail = len - index - count;
+      if (std::is_constant_evaluated()) {
+        for (std::size_t i = 0; i < tail; i++)
+          relocate(from + count + i, from + count + i + 1, from + i);
+      } else if (tail > 0 && count > 0) {
+        std::memmove(static_cast<void *>(from), from + count, tail * sizeof(T));
+      }
+      len -= static_cast<SizeType>(count);
+    } else {
+      std::move(from + count, end(), from);
+      truncate(len - count);
+    }
+    return begin() + index;
+  }
+
+  constexpr void swap(SmallVec &rhs) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc, rhs.alloc);
+    } else {
+      assert(alloc == rhs.alloc);
+    }
+    if (onHeap() && rhs.onHeap()) {
+      std::swap(impl.heap, rhs.impl.heap);
+    } else if (onStack() && rhs.onStack()) {
+      auto common = std::min(len, rhs.len);
+      std::swap_ranges(impl.stack, impl.stack + common, rhs.impl.stack);
+      if (len > common)
+        relocate(impl.stack + common, impl.stack + len, rhs.impl.stack + common);
+      else
+        relocate(rhs.impl.stack + common, rhs.impl.stack + rhs.len, impl.stack + common);
+    } else {
+      auto &inlineVec = onStack() ? *this : rhs;
+      auto &heapVec = onStack() ? rhs : *this;
+      T *heapPtr = heapVec.impl.heap;
+      heapVec.activateStack();
+      relocate(inlineVec.impl.stack, inlineVec.impl.stack + inlineVec.len, heapVec.impl.stack);
+      inlineVec.impl.heap = heapPtr;
+    }
+    std::swap(cap, rhs.cap);
+    std::swap(len, rhs.len);
+    syncDataPointer();
+    rhs.syncDataPointer();
+  }
+
+  friend constexpr void swap(SmallVec &lhs, SmallVec &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+  }
+
+private:
+  // contiguous ranges of T which may be copied bytewise
+  template <typename Iter>
+  static constexpr bool isBulkCopyable = std::contiguous_iterator<Iter>
+      && std::is_same_v<std::remove_cv_t<std::iter_value_t<Iter>>, T>
+      && std::is_trivially_copyable_v<T>;
+
+  constexpr void relocate(T *first, T *last, T *dest) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    detail::relocate(alloc, first, last, dest);
+  }
+
+  constexpr AllocationResult<T *> allocateAtLeast(std::size_t n) {
+    if constexpr (AllocatesAtLeast<Allocator>)
+      return alloc.allocateAtLeast(n);
+    else
+      return {AllocTraits::allocate(alloc, n), n};
+  }
+
+  template <typename... Args>
+  constexpr T &growAndEmplaceBack(Args &&...args) {
+    // args may refer to our own elements, so build the value before they are relocated
+    T value(std::forward<Args>(args)...);
+    reserve(1);
+    return emplaceBackUnchecked(std::move(value));
+  }
+
+  template <bool Exact, bool Consuming, typename Iter>
+  constexpr void extendFrom(Iter begin, Iter end) {
+    if constexpr (std::forward_iterator<Iter>) {
+      auto size = static_cast<std::size_t>(std::distance(begin, end));
+      if constexpr (Exact)
+        reserveExact(size);
+      else
+        reserve(size);
+      if constexpr (Consuming && !isBulkCopyable<Iter>)
+        appendReserved(std::make_move_iterator(begin), std::make_move_iterator(end), size);
+      else
+        appendReserved(begin, end, size);
+    } else {
+      // single pass, the size is unknown up front
+      for (; begin != end; ++begin) {
+        if constexpr (Consuming)
+          emplaceBack(std::move(*begin));
+        else
+          emplaceBack(*begin);
+      }
+    }
+  }
+
+  // appends [first, last) of `size` elements into already reserved capacity
+  template <typename Iter, typename Sentinel>
+  constexpr void appendReserved(Iter first, Sentinel last, std::size_t size) {
+    assert(capacity() - this->size() >= size);
+    if constexpr (isBulkCopyable<Iter>) {
+      if (!std::is_constant_evaluated()) {
+        if (size > 0)
+          std::memcpy(data() + len, std::to_address(first), size * sizeof(T));
+        len += static_cast<SizeType>(size);
+        return;
+      }
+    }
+    for (; first != last; ++first)
+      emplaceBackUnchecked(*first);
+  }
+
+  // relocates [index, len) `count` slots to the right, leaving uninitialized slots behind,
+  // capacity must already suffice and `len` is left as is
+  constexpr void openGap(std::size_t index, std::size_t count) noexcept
+    requires isTriviallyRelocatable<T>
+  {
+    assert(capacity() - size() >= count);
+    auto tail = len - index;
+    if (std::is_constant_evaluated()) {
+      // back to front, so that no live element is overwritten
+      for (auto i = tail; i-- > 0;)
+        relocate(data() + index + i, data() + index + i + 1, data() + index + count + i);
+    } else if (tail > 0 && count > 0) {
+      std::memmove(static_cast<void *>(data() + index + count), data() + index, tail * sizeof(T));
+    }
+  }
+
+  // destruction is a no-op unless T or the allocator have something to do
+  static constexpr bool isTriviallyDestroyed = std::is_trivially_destructible_v<T>
+      && (!requires(Allocator &alloc, T *ptr) { alloc.destroy(ptr); }
+          || std::is_same_v<Allocator, std::pmr::polymorphic_allocator<T>>);
+
+  constexpr void destroyRange(T *first, T *last) noexcept {
+    if constexpr (!isTriviallyDestroyed) {
+      for (; first != last; ++first)
+        AllocTraits::destroy(alloc, first);
+    }
+  }
+
+  // destroys elements past `n`
+  constexpr void truncate(std::size_t n) noexcept {
+    if (n >= len)
+      return;
+    destroyRange(data() + n, data() + len);
+    len = static_cast<SizeType>(n);
+  }
+
+  // Constant evaluation only constructs elements into the active union member and
+  // `impl()` activates none, so whenever storage becomes inline `stack` is activated
+  // by recreating the union with it value-initialized, and its elements are destroyed
+  // again to leave bare storage. At runtime, and for T without a default constructor,
+  // this only clears the moved-from marker of the stats build, see `markMovedFrom`
+  constexpr void activateStack() noexcept {
+    if (std::is_constant_evaluated()) {
+      if constexpr (std::is_default_constructible_v<T>) {
+        std::construct_at(&impl, ActiveStack{});
+        std::destroy(impl.stack, impl.stack + N);
+      }
+      return;
+    }
+#ifdef SMALLVEC_ENABLE_STATS
+    impl.heap = nullptr;
+#endif
+  }
+
+  // to be called after the buffer changed between inline and heap storage
+  constexpr void syncDataPointer() noexcept {
+    if constexpr (storesDataPointer)
+      ptr = onHeap() ? impl.heap : impl.stack;
+  }
+
+  // destroys all elements and returns to the empty inline state
+  constexpr void dispose() noexcept {
+    destroyRange(begin(), end());
+    if (onHeap()) {
+      AllocTraits::deallocate(alloc, impl.heap, cap);
+      activateStack();
+    }
+    cap = N;
+    len = 0;
+    syncDataPointer();
+  }
+
+  // expects `this` to be empty and inline, leaves `rhs` empty and inline
+  constexpr void steal(SmallVec &rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (rhs.onHeap()) {
+      // adopt the heap buffer as is
+      impl.heap = rhs.impl.heap;
+      cap = rhs.cap;
+      len = rhs.len;
+      rhs.cap = N;
+      rhs.len = 0;
+      rhs.activateStack();
+      syncDataPointer();
+      rhs.syncDataPointer();
+      rhs.markMovedFrom();
+      return;
+    }
+    relocate(rhs.begin(), rhs.end(), impl.stack);
+    len = rhs.len;
+    rhs.len = 0;
+    rhs.markMovedFrom();
+  }
+
+  // A moved-from vector is empty and inline, so the heap pointer slot of the union is
+  // free. It is set to a marker which destroying the vector while still empty checks for.
+  // Elements constructed later overwrite it, and `activateStack` clears it whenever
+  // storage becomes inline, so every constructor leaves the slot initialized
+  constexpr void markMovedFrom() noexcept {
+#ifdef SMALLVEC_ENABLE_STATS
+    if (!std::is_constant_evaluated()) {
+      stats::of<SmallVec, T>().recordMove();
+      impl.heap = movedFromMarker();
+    }
+#endif
+  }
+
+#ifdef SMALLVEC_ENABLE_STATS
+  // the address of the type's counters, which no element pointer can equal
+  static T *movedFromMarker() noexcept {
+    return reinterpret_cast<T *>(&stats::of<SmallVec, T>());
+  }
+
+  // the slot is read as bytes, the inline elements may be the active member
+  bool isMovedFrom() const noexcept {
+    if (len != 0 || onHeap())
+      return false;
+    T *slot;
+    std::memcpy(&slot, &impl, sizeof(slot));
+    return slot == movedFromMarker();
+  }
+#endif
 };
 
-template <std::size_t N, typename T, template <typename> typename Container>
-auto fromContainer(Container<T> &&data) {
+template <typename T, std::size_t N, typename Allocator, typename GrowthPolicy, typename SizeType, typename Layout, typename U>
+constexpr std::size_t erase(SmallVec<T, N, Allocator, GrowthPolicy, SizeType, Layout> &vec, const U &value) {
+  return vec.retain([&](const T &item) { return !(item == value); });
+}
+
+template <typename T, std::size_t N, typename Allocator, typename GrowthPolicy, typename SizeType, typename Layout, typename Pred>
+constexpr std::size_t erase_if(SmallVec<T, N, Allocator, GrowthPolicy, SizeType, Layout> &vec, Pred pred) {
+  return vec.retain([&](const T &item) { return !std::invoke(pred, item); });
+}
+
+// moves all elements with a single allocation and leaves `data` empty if it can be cleared
+template <std::size_t N, typename T, template <typename...> typename Container, typename... Params>
+constexpr auto fromContainer(Container<T, Params...> &&data) {
   SmallVec<T, N> result;
-  result.extendConsuming(std::begin(data), std::end(data));
+  result.extendConsumingExact(std::begin(data), std::end(data));
+  if constexpr (requires { data.clear(); })
+    data.clear();
   return result;
 }
 
 template <std::size_t N, typename T>
-auto fromContainer(T *data, std::size_t n) {
+constexpr auto fromContainer(T *data, std::size_t n) {
   SmallVec<T, N> result;
-  result.extendConsuming(data, data + n);
+  result.extendConsumingExact(data, data + n);
   return result;
 }
 
 template <typename T, std::size_t M, std::size_t N = M>
-auto fromContainer(std::array<T, M> data) {
+constexpr auto fromContainer(std::array<T, M> data) {
   SmallVec<T, N> result;
-  result.extendConsuming(data.begin(), data.end());
+  result.extendConsumingExact(data.begin(), data.end());
+  return result;
+}
+
+// Runs the captureless lambda `build` at compile time and copies the vector it returns
+// into a std::array of exactly its size. A vector with unused inline slots or a heap
+// buffer can't be kept in a constexpr variable, the array can
+template <typename Build>
+consteval auto toArray(Build) {
+  using Vec = std::invoke_result_t<Build>;
+  constexpr std::size_t size = Build{}().size();
+  std::array<std::ranges::range_value_t<Vec>, size> result{};
+  auto vec = Build{}();
+  std::move(vec.begin(), vec.end(), result.begin());
   return result;
 }
 
+template <typename T, std::size_t N>
+using PointerLayoutSmallVec = SmallVec<T, N, std::allocator<T>, PowerOfTwoGrowth, std::size_t, PointerLayout>;
+
+template <typename T, std::size_t N, typename SizeType = std::uint32_t>
+using CompactSmallVec = SmallVec<T, N, std::allocator<T>, PowerOfTwoGrowth, SizeType>;
+
+namespace detail {
+template <typename T, std::size_t Bytes, typename SizeType>
+struct CapacityForBytes {
+  // the union is aligned for both T and the heap pointer, the counters follow it
+  static constexpr std::size_t alignment = std::max(alignof(T), alignof(T *));
+  static constexpr std::size_t counters = 2 * sizeof(SizeType);
+  static_assert(Bytes > counters, "byte budget does not fit the counters");
+
+  static constexpr std::size_t value = (Bytes - counters) / alignment * alignment / sizeof(T);
+  static_assert(value > 0, "byte budget does not fit a single element");
+  static_assert(sizeof(SmallVec<T, value, std::allocator<T>, PowerOfTwoGrowth, SizeType>) <= Bytes);
+};
+}// namespace detail
+
+// SmallVec with the largest inline capacity for which the whole object fits into `Bytes`
+template <typename T, std::size_t Bytes = 64, typename SizeType = std::size_t>
+using SmallVecBytes = SmallVec<T, detail::CapacityForBytes<T, Bytes, SizeType>::value, std::allocator<T>, PowerOfTwoGrowth, SizeType>;
+
 template <typename T, std::size_t N>
 SmallVec(T(&&)[N]) -> SmallVec<T, N>;
 
@@ -244,4 +1137,28 @@ SmallVec(T (&)[N]) -> SmallVec<T, N>;
 
 template <typename T, typename... U>
 SmallVec(T, U...) -> SmallVec<T, 1 + sizeof...(U)>;
-}// namespace smallvec
\ No newline at end of file
+
+namespace pmr {
+template <typename T, std::size_t N>
+using SmallVec = smallvec::SmallVec<T, N, std::pmr::polymorphic_allocator<T>>;
+}
+}// namespace smallvec
+
+// Instantiations compiled into the smallvec library in SMALLVEC_EXPLICIT_INSTANTIATIONS mode
+#define SMALLVEC_FOR_EACH_COMMON_INSTANTIATION(X) \
+  X(int, 8)                                       \
+  X(int, 16)                                      \
+  X(std::uint8_t, 16)                             \
+  X(std::uint8_t, 64)                             \
+  X(std::string, 4)                               \
+  X(std::string, 16)
+
+#ifdef SMALLVEC_EXTERN_TEMPLATES
+#include <string>
+
+#define SMALLVEC_EXTERN_TEMPLATE(T, N)                                          \
+  extern template class smallvec::detail::VecBase<smallvec::SmallVec<T, N>, T>; \
+  extern template class smallvec::SmallVec<T, N>;
+SMALLVEC_FOR_EACH_COMMON_INSTANTIATION(SMALLVEC_EXTERN_TEMPLATE)
+#undef SMALLVEC_EXTERN_TEMPLATE
+#endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "SmallVec.hpp"
+
+namespace smallvec {
+// element types which read(2) can fill byte by byte
+template <typename T>
+concept ByteLike = sizeof(T) == 1 && std::is_trivially_copyable_v<T>;
+
+// Reads at most `maxBytes` from `fd` into the spare capacity of `vec`, so the bytes land
+// in their final place without a staging buffer. While there is spare capacity, inline
+// or on the heap, the read is limited to it and nothing is allocated. Otherwise the tail
+// grows by exactly `maxBytes`, or by the current size for long streams, which keeps
+// reading in a loop linear. Returns the result of read(2): the number of bytes appended,
+// 0 at end of file, or -1 with errno set, in which case `vec` keeps its contents.
+// Interrupted reads are retried
+template <ByteLike T, std::size_t N, typename Allocator, typename GrowthPolicy, typename SizeType, typename Layout>
+ssize_t appendFromFd(SmallVec<T, N, Allocator, GrowthPolicy, SizeType, Layout> &vec, int fd, std::size_t maxBytes) {
+  auto oldSize = vec.size();
+  if (vec.capacity() == oldSize)
+    vec.reserveExact(std::max(maxBytes, oldSize));
+  auto count = std::min(maxBytes, vec.capacity() - oldSize);
+  vec.resizeForOverwrite(oldSize + count);
+  ssize_t result;
+  do {
+    result = ::read(fd, vec.data() + oldSize, count);
+  } while (result < 0 && errno == EINTR);
+  auto error = errno;
+  vec.resizeForOverwrite(oldSize + (result > 0 ? static_cast<std::size_t>(result) : 0));
+  errno = error;
+  return result;
+}
+
+// One iovec per non-empty buffer of `buffers`, e.g. a range of SmallVecs, for writev(2)
+// or io_uring scatter-gather writes. The iovecs point into the buffers, which must
+// outlive them. Callers sending more than IOV_MAX buffers have to split the result
+template <std::size_t K = 16, std::ranges::input_range R>
+  requires std::ranges::contiguous_range<std::ranges::range_reference_t<R>>
+SmallVec<iovec, K> toIovecs(R &&buffers) {
+  SmallVec<iovec, K> result;
+  if constexpr (std::ranges::sized_range<R>)
+    result.reserve(std::ranges::size(buffers));
+  for (auto &&buffer : buffers) {
+    auto bytes = std::ranges::size(buffer) * sizeof(std::ranges::range_value_t<decltype(buffer)>);
+    if (bytes == 0)
+      continue;
+    // iovec is shared by reads and writes, hence the non-const base
+    auto *base = const_cast<void *>(static_cast<const void *>(std::ranges::data(buffer)));
+    result.push(iovec{base, bytes});
+  }
+  return result;
+}
+}// namespace smallvec
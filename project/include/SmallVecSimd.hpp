@@ -0,0 +1,257 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define SMALLVEC_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define SMALLVEC_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Vectorized linear searches over contiguous arithmetic elements, used by
+// SmallVec::find, contains and count. SSE2 (always present on x86-64) handles
+// short ranges inline, AVX2 is picked at run time for longer ones unless the
+// build already targets it. AArch64 uses NEON, everything else a scalar loop.
+// Floating point lanes compare like operator==, so NaN is never found.
+namespace smallvec::simd {
+template <typename T>
+concept Vectorizable = (std::is_integral_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8))
+    || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+namespace detail {
+template <typename T>
+inline std::size_t findScalar(const T *data, std::size_t n, T value) noexcept {
+  for (std::size_t i = 0; i < n; i++) {
+    if (data[i] == value)
+      return i;
+  }
+  return n;
+}
+
+template <typename T>
+inline std::size_t countScalar(const T *data, std::size_t n, T value) noexcept {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < n; i++)
+    result += data[i] == value;
+  return result;
+}
+
+#ifdef SMALLVEC_SIMD_X86
+template <typename T>
+inline __m128i broadcast128(T value) noexcept {
+  if constexpr (std::is_same_v<T, float>)
+    return _mm_castps_si128(_mm_set1_ps(value));
+  else if constexpr (std::is_same_v<T, double>)
+    return _mm_castpd_si128(_mm_set1_pd(value));
+  else if constexpr (sizeof(T) == 1)
+    return _mm_set1_epi8(static_cast<char>(value));
+  else if constexpr (sizeof(T) == 2)
+    return _mm_set1_epi16(static_cast<short>(value));
+  else if constexpr (sizeof(T) == 4)
+    return _mm_set1_epi32(static_cast<int>(value));
+  else
+    return _mm_set1_epi64x(static_cast<long long>(value));
+}
+
+// one bit per byte of the 16 bytes at `data`, set for the lanes equal to `needle`
+template <typename T>
+inline unsigned equalMask128(const T *data, __m128i needle) noexcept {
+  auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  __m128i equal;
+  if constexpr (std::is_same_v<T, float>) {
+    equal = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(chunk), _mm_castsi128_ps(needle)));
+  } else if constexpr (std::is_same_v<T, double>) {
+    equal = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(chunk), _mm_castsi128_pd(needle)));
+  } else if constexpr (sizeof(T) == 1) {
+    equal = _mm_cmpeq_epi8(chunk, needle);
+  } else if constexpr (sizeof(T) == 2) {
+    equal = _mm_cmpeq_epi16(chunk, needle);
+  } else if constexpr (sizeof(T) == 4) {
+    equal = _mm_cmpeq_epi32(chunk, needle);
+  } else {
+    // SSE2 has no 64 bit compare, both halves have to match
+    auto halves = _mm_cmpeq_epi32(chunk, needle);
+    equal = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+  }
+  return static_cast<unsigned>(_mm_movemask_epi8(equal));
+}
+
+template <typename T>
+inline std::size_t findSse2(const T *data, std::size_t n, T value) noexcept {
+  constexpr std::size_t lanes = 16 / sizeof(T);
+  auto needle = broadcast128(value);
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    if (auto mask = equalMask128(data + i, needle))
+      return i + std::countr_zero(mask) / sizeof(T);
+  }
+  return i + findScalar(data + i, n - i, value);
+}
+
+template <typename T>
+inline std::size_t countSse2(const T *data, std::size_t n, T value) noexcept {
+  constexpr std::size_t lanes = 16 / sizeof(T);
+  auto needle = broadcast128(value);
+  std::size_t bits = 0;
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes)
+    bits += std::popcount(equalMask128(data + i, needle));
+  return bits / sizeof(T) + countScalar(data + i, n - i, value);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) inline __m256i broadcast256(T value) noexcept {
+  if constexpr (std::is_same_v<T, float>)
+    return _mm256_castps_si256(_mm256_set1_ps(value));
+  else if constexpr (std::is_same_v<T, double>)
+    return _mm256_castpd_si256(_mm256_set1_pd(value));
+  else if constexpr (sizeof(T) == 1)
+    return _mm256_set1_epi8(static_cast<char>(value));
+  else if constexpr (sizeof(T) == 2)
+    return _mm256_set1_epi16(static_cast<short>(value));
+  else if constexpr (sizeof(T) == 4)
+    return _mm256_set1_epi32(static_cast<int>(value));
+  else
+    return _mm256_set1_epi64x(static_cast<long long>(value));
+}
+
+template <typename T>
+__attribute__((target("avx2"))) inline unsigned equalMask256(const T *data, __m256i needle) noexcept {
+  auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  __m256i equal;
+  if constexpr (std::is_same_v<T, float>)
+    equal = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(chunk), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+  else if constexpr (std::is_same_v<T, double>)
+    equal = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(chunk), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+  else if constexpr (sizeof(T) == 1)
+    equal = _mm256_cmpeq_epi8(chunk, needle);
+  else if constexpr (sizeof(T) == 2)
+    equal = _mm256_cmpeq_epi16(chunk, needle);
+  else if constexpr (sizeof(T) == 4)
+    equal = _mm256_cmpeq_epi32(chunk, needle);
+  else
+    equal = _mm256_cmpeq_epi64(chunk, needle);
+  return static_cast<unsigned>(_mm256_movemask_epi8(equal));
+}
+
+template <typename T>
+__attribute__((target("avx2"))) std::size_t findAvx2(const T *data, std::size_t n, T value) noexcept {
+  constexpr std::size_t lanes = 32 / sizeof(T);
+  auto needle = broadcast256(value);
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    if (auto mask = equalMask256(data + i, needle))
+      return i + std::countr_zero(mask) / sizeof(T);
+  }
+  return i + findSse2(data + i, n - i, value);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) std::size_t countAvx2(const T *data, std::size_t n, T value) noexcept {
+  constexpr std::size_t lanes = 32 / sizeof(T);
+  auto needle = broadcast256(value);
+  std::size_t bits = 0;
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes)
+    bits += std::popcount(equalMask256(data + i, needle));
+  return bits / sizeof(T) + countSse2(data + i, n - i, value);
+}
+
+inline bool hasAvx2() noexcept {
+#ifdef __AVX2__
+  return true;
+#else
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#endif
+}
+
+// below this many bytes a single SSE2 pass beats checking for AVX2
+constexpr std::size_t avx2MinBytes = 64;
+#endif
+
+#ifdef SMALLVEC_SIMD_NEON
+template <typename T>
+inline uint8x16_t equalLanes(const T *data, T value) noexcept {
+  if constexpr (std::is_same_v<T, float>)
+    return vreinterpretq_u8_u32(vceqq_f32(vld1q_f32(data), vdupq_n_f32(value)));
+  else if constexpr (std::is_same_v<T, double>)
+    return vreinterpretq_u8_u64(vceqq_f64(vld1q_f64(data), vdupq_n_f64(value)));
+  else if constexpr (sizeof(T) == 1)
+    return vceqq_u8(vld1q_u8(reinterpret_cast<const std::uint8_t *>(data)), vdupq_n_u8(static_cast<std::uint8_t>(value)));
+  else if constexpr (sizeof(T) == 2)
+    return vreinterpretq_u8_u16(vceqq_u16(vld1q_u16(reinterpret_cast<const std::uint16_t *>(data)),
+                                          vdupq_n_u16(static_cast<std::uint16_t>(value))));
+  else if constexpr (sizeof(T) == 4)
+    return vreinterpretq_u8_u32(vceqq_u32(vld1q_u32(reinterpret_cast<const std::uint32_t *>(data)),
+                                          vdupq_n_u32(static_cast<std::uint32_t>(value))));
+  else
+    return vreinterpretq_u8_u64(vceqq_u64(vld1q_u64(reinterpret_cast<const std::uint64_t *>(data)),
+                                          vdupq_n_u64(static_cast<std::uint64_t>(value))));
+}
+
+// four bits per byte, set for the lanes which compared equal
+inline std::uint64_t nibbleMask(uint8x16_t equal) noexcept {
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+}
+
+template <typename T>
+inline std::size_t findNeon(const T *data, std::size_t n, T value) noexcept {
+  constexpr std::size_t lanes = 16 / sizeof(T);
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    if (auto mask = nibbleMask(equalLanes(data + i, value)))
+      return i + std::countr_zero(mask) / (4 * sizeof(T));
+  }
+  return i + findScalar(data + i, n - i, value);
+}
+
+template <typename T>
+inline std::size_t countNeon(const T *data, std::size_t n, T value) noexcept {
+  constexpr std::size_t lanes = 16 / sizeof(T);
+  std::size_t bytes = 0;
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes)
+    bytes += vaddvq_u8(vshrq_n_u8(equalLanes(data + i, value), 7));
+  return bytes / sizeof(T) + countScalar(data + i, n - i, value);
+}
+#endif
+}// namespace detail
+
+// index of the first element equal to `value`, `n` if there is none
+template <Vectorizable T>
+inline std::size_t find(const T *data, std::size_t n, T value) noexcept {
+#if defined(SMALLVEC_SIMD_X86)
+  if (n * sizeof(T) >= detail::avx2MinBytes && detail::hasAvx2())
+    return detail::findAvx2(data, n, value);
+  return detail::findSse2(data, n, value);
+#elif defined(SMALLVEC_SIMD_NEON)
+  return detail::findNeon(data, n, value);
+#else
+  return detail::findScalar(data, n, value);
+#endif
+}
+
+template <Vectorizable T>
+inline std::size_t count(const T *data, std::size_t n, T value) noexcept {
+#if defined(SMALLVEC_SIMD_X86)
+  if (n * sizeof(T) >= detail::avx2MinBytes && detail::hasAvx2())
+    return detail::countAvx2(data, n, value);
+  return detail::countSse2(data, n, value);
+#elif defined(SMALLVEC_SIMD_NEON)
+  return detail::countNeon(data, n, value);
+#else
+  return detail::countScalar(data, n, value);
+#endif
+}
+}// namespace smallvec::simd
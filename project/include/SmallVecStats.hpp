@@ -0,0 +1,138 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <typeinfo>
+#include <vector>
+
+// Spill instrumentation, compiled into SmallVec when SMALLVEC_ENABLE_STATS is defined.
+// Every SmallVec instantiation gets its own counters, which register themselves
+// in the global Registry on first use.
+namespace smallvec::stats {
+struct SpillStats {
+  // mangled name of the SmallVec instantiation
+  const char *name;
+  std::size_t inlineCapacity;
+  std::size_t elementSize;
+
+  // grows from inline storage to the heap
+  std::atomic<std::size_t> spills{0};
+  // grows from one heap buffer to another
+  std::atomic<std::size_t> reallocations{0};
+  // destroyed vectors, except empty moved-from ones
+  std::atomic<std::size_t> destroyed{0};
+  // moves out of a vector, whose elements then count towards the destination
+  std::atomic<std::size_t> movedFrom{0};
+  // largest size seen when growing or at destruction
+  std::atomic<std::size_t> peakSize{0};
+  // bucket i counts vectors destroyed with a size in [2^(i-1), 2^i), bucket 0 the empty ones
+  std::array<std::atomic<std::size_t>, 65> sizeHistogram{};
+
+  SpillStats(const char *name, std::size_t inlineCapacity, std::size_t elementSize)
+      : name(name),
+        inlineCapacity(inlineCapacity),
+        elementSize(elementSize) {}
+
+  void recordGrow(bool fromInline, std::size_t size) {
+    if (fromInline)
+      spills.fetch_add(1, std::memory_order_relaxed);
+    else
+      reallocations.fetch_add(1, std::memory_order_relaxed);
+    recordPeak(size);
+  }
+
+  void recordMove() {
+    movedFrom.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void recordDestruction(std::size_t size) {
+    destroyed.fetch_add(1, std::memory_order_relaxed);
+    sizeHistogram[std::bit_width(size)].fetch_add(1, std::memory_order_relaxed);
+    recordPeak(size);
+  }
+
+  void reset() {
+    spills = 0;
+    reallocations = 0;
+    destroyed = 0;
+    movedFrom = 0;
+    peakSize = 0;
+    for (auto &bucket : sizeHistogram)
+      bucket = 0;
+  }
+
+private:
+  void recordPeak(std::size_t size) {
+    auto peak = peakSize.load(std::memory_order_relaxed);
+    while (size > peak && !peakSize.compare_exchange_weak(peak, size, std::memory_order_relaxed)) {}
+  }
+};
+
+class Registry {
+  std::mutex mutex;
+  std::vector<SpillStats *> entries;
+
+  Registry() = default;
+
+public:
+  static Registry &instance() {
+    static Registry registry;
+    return registry;
+  }
+
+  void add(SpillStats *stats) {
+    std::lock_guard lock(mutex);
+    entries.push_back(stats);
+  }
+
+  template <typename F>
+  void forEach(F &&f) {
+    std::lock_guard lock(mutex);
+    for (auto *stats : entries)
+      f(*stats);
+  }
+
+  void reset() {
+    forEach([](SpillStats &stats) { stats.reset(); });
+  }
+
+  void dump(std::ostream &out) {
+    forEach([&](const SpillStats &stats) {
+      out << stats.name << " (N = " << stats.inlineCapacity << ", sizeof(T) = " << stats.elementSize << ")\n"
+          << "  spills: " << stats.spills << ", reallocations: " << stats.reallocations
+          << ", destroyed: " << stats.destroyed << ", moved from: " << stats.movedFrom
+          << ", peak size: " << stats.peakSize << '\n'
+          << "  final sizes:";
+      for (std::size_t i = 0; i < stats.sizeHistogram.size(); i++) {
+        auto count = stats.sizeHistogram[i].load(std::memory_order_relaxed);
+        if (count == 0)
+          continue;
+        if (i == 0)
+          out << " [0]: " << count;
+        else
+          out << " [" << (std::size_t(1) << (i - 1)) << ", " << ((std::size_t(1) << (i - 1)) * 2 - 1) << "]: " << count;
+      }
+      out << '\n';
+    });
+  }
+};
+
+template <typename Vec, typename T>
+SpillStats &of() {
+  // never freed, so vectors destroyed during static destruction can still record
+  static SpillStats *stats = [] {
+    auto *result = new SpillStats(typeid(Vec).name(), Vec::inlineCapacity, sizeof(T));
+    Registry::instance().add(result);
+    return result;
+  }();
+  return *stats;
+}
+}// namespace smallvec::stats
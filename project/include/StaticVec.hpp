@@ -0,0 +1,369 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "SmallVec.hpp"
+
+namespace smallvec {
+namespace detail {
+template <std::size_t N>
+using SmallestSizeType = std::conditional_t<
+    N <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+    std::conditional_t<N <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t,
+                       std::conditional_t<N <= std::numeric_limits<std::uint32_t>::max(), std::uint32_t, std::size_t>>>;
+}// namespace detail
+
+// Fixed-capacity sibling of SmallVec which never allocates. Only the length is
+// stored next to the buffer, in the smallest integer able to hold N. Element access,
+// searches and comparisons come from the same detail::VecBase as SmallVec's.
+// Growing past N throws std::length_error, `tryPush`/`tryEmplaceBack` report it instead.
+// Everything is constexpr and trivially destructible element types give a
+// trivially destructible StaticVec.
+template <typename T, std::size_t N, typename SizeType = detail::SmallestSizeType<N>>
+class StaticVec : public detail::VecBase<StaticVec<T, N, SizeType>, T> {
+  static_assert(std::is_unsigned_v<SizeType>, "SizeType must be an unsigned integer");
+  static_assert(N <= std::numeric_limits<SizeType>::max(), "capacity does not fit into SizeType");
+
+  using Base = detail::VecBase<StaticVec, T>;
+  friend Base;
+
+public:
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  using Base::back;
+  using Base::begin;
+  using Base::clear;
+  using Base::end;
+  using Base::pop;
+
+private:
+  // members are left uninitialized, only `len` elements are ever alive
+  struct ActiveStack {};
+
+  union StaticVecData {
+    constexpr StaticVecData() noexcept {}
+    // only used during constant evaluation, see `activateStack`
+    constexpr explicit StaticVecData(ActiveStack) : stack() {}
+    constexpr ~StaticVecData()
+      requires std::is_trivially_destructible_v<T>
+    = default;
+    constexpr ~StaticVecData() {}
+
+    T stack[N];
+  } impl;
+  SizeType len;
+
+public:
+  static constexpr auto inlineCapacity = N;
+
+  constexpr StaticVec() noexcept : impl(), len(0) {
+    activateStack();
+  }
+
+  constexpr StaticVec(const StaticVec &rhs) : impl(), len(0) {
+    activateStack();
+    extendCopying(rhs.begin(), rhs.end());
+  }
+
+  constexpr StaticVec(StaticVec &&rhs) noexcept(std::is_nothrow_move_constructible_v<T>) : impl(), len(0) {
+    activateStack();
+    extendConsuming(rhs.begin(), rhs.end());
+    rhs.clear();
+  }
+
+  template <std::size_t M>
+  constexpr StaticVec(T(&&data)[M]) : impl(), len(0) {
+    activateStack();
+    static_assert(M <= N, "too many elements for StaticVec");
+    extendConsuming(data, data + M);
+  }
+
+  template <std::size_t M>
+  constexpr StaticVec(T (&data)[M]) : impl(), len(0) {
+    activateStack();
+    static_assert(M <= N, "too many elements for StaticVec");
+    extendCopying(data, data + M);
+  }
+
+  template <typename... U>
+    requires(std::is_convertible_v<U, T> && ...)
+  constexpr StaticVec(U... tail)
+      : StaticVec({tail...}) {}
+
+  constexpr StaticVec &operator=(const StaticVec &rhs) {
+    if (this != &rhs) {
+      auto overwritten = std::min(len, rhs.len);
+      std::copy(rhs.begin(), rhs.begin() + overwritten, begin());
+      truncate(overwritten);
+      extendCopying(rhs.begin() + overwritten, rhs.end());
+    }
+    return *this;
+  }
+
+  constexpr StaticVec &operator=(StaticVec &&rhs) noexcept(std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+    if (this != &rhs) {
+      auto overwritten = std::min(len, rhs.len);
+      std::move(rhs.begin(), rhs.begin() + overwritten, begin());
+      truncate(overwritten);
+      extendConsuming(rhs.begin() + overwritten, rhs.end());
+      rhs.clear();
+    }
+    return *this;
+  }
+
+  constexpr ~StaticVec()
+    requires std::is_trivially_destructible_v<T>
+  = default;
+
+  constexpr ~StaticVec() {
+    clear();
+  }
+
+  [[nodiscard]] static constexpr bool onHeap() { return false; }
+  [[nodiscard]] static constexpr bool onStack() { return true; }
+
+  [[nodiscard]] static constexpr std::size_t maxSize() { return N; }
+
+  [[nodiscard]] constexpr std::size_t size() const { return len; }
+
+  [[nodiscard]] static constexpr std::size_t capacity() { return N; }
+
+  [[nodiscard]] constexpr bool full() const { return len == N; }
+
+  [[nodiscard]] static constexpr std::size_t takenSize() { return sizeof(StaticVec); }
+
+  constexpr iterator data() { return impl.stack; }
+
+  constexpr const_iterator data() const { return impl.stack; }
+
+  // there is nothing to reserve, only checks that `additional` elements still fit
+  constexpr void reserve(std::size_t additional) const {
+    if (additional > N - len)
+      throw std::length_error("StaticVec capacity exceeded");
+  }
+
+  template <typename U>
+  constexpr void push(U &&value) {
+    emplaceBack(std::forward<U>(value));
+  }
+
+  // expects spare capacity
+  template <typename U>
+  constexpr void pushUnchecked(U &&value) {
+    emplaceBackUnchecked(std::forward<U>(value));
+  }
+
+  // returns false and leaves the vector untouched when it is full
+  template <typename U>
+  [[nodiscard]] constexpr bool tryPush(U &&value) {
+    return tryEmplaceBack(std::forward<U>(value)) != nullptr;
+  }
+
+  template <typename... Args>
+  constexpr T &emplaceBack(Args &&...args) {
+    reserve(1);
+    return emplaceBackUnchecked(std::forward<Args>(args)...);
+  }
+
+  // expects spare capacity
+  template <typename... Args>
+  constexpr T &emplaceBackUnchecked(Args &&...args) {
+    assert(len < N);
+    T *slot = std::construct_at(data() + len, std::forward<Args>(args)...);
+    len++;
+    return *slot;
+  }
+
+  // returns nullptr when the vector is full
+  template <typename... Args>
+  [[nodiscard]] constexpr T *tryEmplaceBack(Args &&...args) {
+    if (full())
+      return nullptr;
+    return &emplaceBackUnchecked(std::forward<Args>(args)...);
+  }
+
+  template <typename Iter>
+  constexpr void extendConsuming(Iter begin, Iter end) {
+    if constexpr (std::forward_iterator<Iter>)
+      reserve(static_cast<std::size_t>(std::distance(begin, end)));
+    for (; begin != end; ++begin)
+      emplaceBack(std::move(*begin));
+  }
+
+  template <typename Iter>
+  constexpr void extendCopying(Iter begin, Iter end) {
+    if constexpr (std::forward_iterator<Iter>)
+      reserve(static_cast<std::size_t>(std::distance(begin, end)));
+    for (; begin != end; ++begin)
+      emplaceBack(*begin);
+  }
+
+  template <std::ranges::input_range R>
+  constexpr void appendRange(R &&range) {
+    if constexpr (std::ranges::sized_range<R>)
+      reserve(static_cast<std::size_t>(std::ranges::size(range)));
+    for (auto &&item : range)
+      emplaceBack(std::forward<decltype(item)>(item));
+  }
+
+  constexpr void append(std::size_t count, const T &value) {
+    reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+      emplaceBackUnchecked(value);
+  }
+
+  constexpr void resize(std::size_t n) {
+    if (n <= len)
+      return truncate(n);
+    reserve(n - len);
+    while (len < n)
+      emplaceBackUnchecked();
+  }
+
+  constexpr void resize(std::size_t n, const T &value) {
+    if (n <= len)
+      return truncate(n);
+    append(n - len, value);
+  }
+
+  template <typename... Args>
+  constexpr iterator emplace(const_iterator pos, Args &&...args) {
+    auto index = static_cast<std::size_t>(pos - begin());
+    assert(index <= len);
+    emplaceBack(std::forward<Args>(args)...);
+    std::rotate(begin() + index, end() - 1, end());
+    return begin() + index;
+  }
+
+  constexpr iterator insert(const_iterator pos, const T &value) {
+    return emplace(pos, value);
+  }
+
+  constexpr iterator insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  constexpr iterator insert(const_iterator pos, std::size_t count, const T &value) {
+    auto index = static_cast<std::size_t>(pos - begin());
+    assert(index <= len);
+    auto oldLen = len;
+    append(count, value);
+    std::rotate(begin() + index, begin() + oldLen, end());
+    return begin() + index;
+  }
+
+  // [first, last) must not point into this vector
+  template <std::input_iterator Iter>
+  constexpr iterator insert(const_iterator pos, Iter first, Iter last) {
+    auto index = static_cast<std::size_t>(pos - begin());
+    assert(index <= len);
+    auto oldLen = len;
+    extendCopying(first, last);
+    std::rotate(begin() + index, begin() + oldLen, end());
+    return begin() + index;
+  }
+
+  constexpr iterator erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+  }
+
+  constexpr iterator erase(const_iterator first, const_iterator last) {
+    auto index = static_cast<std::size_t>(first - begin());
+    auto count = static_cast<std::size_t>(last - first);
+    assert(index + count <= len);
+    std::move(begin() + index + count, end(), begin() + index);
+    truncate(len - count);
+    return begin() + index;
+  }
+
+  // Replaces the contents, assigning over live elements. Throws std::length_error
+  // before touching anything if [first, last) doesn't fit, which must not point into this vector
+  template <std::input_iterator Iter>
+  constexpr void assign(Iter first, Iter last) {
+    if constexpr (std::forward_iterator<Iter>) {
+      auto count = static_cast<std::size_t>(std::distance(first, last));
+      if (count > N)
+        throw std::length_error("StaticVec capacity exceeded");
+      auto overwritten = std::min(count, size());
+      auto mid = std::next(first, overwritten);
+      std::copy(first, mid, begin());
+      truncate(count);
+      extendCopying(mid, last);
+    } else {
+      auto it = begin();
+      for (; first != last && it != end(); ++first, ++it)
+        *it = *first;
+      truncate(static_cast<std::size_t>(it - begin()));
+      for (; first != last; ++first)
+        emplaceBack(*first);
+    }
+  }
+
+  constexpr void assign(std::size_t count, const T &value) {
+    if (count > N)
+      throw std::length_error("StaticVec capacity exceeded");
+    // elements are never moved, so `value` may refer to one of ours
+    std::fill_n(begin(), std::min(count, size()), value);
+    if (count > size())
+      append(count - size(), value);
+    else
+      truncate(count);
+  }
+
+  constexpr void swap(StaticVec &rhs) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+    auto common = std::min(len, rhs.len);
+    std::swap_ranges(begin(), begin() + common, rhs.begin());
+    auto &longer = len > common ? *this : rhs;
+    auto &shorter = len > common ? rhs : *this;
+    for (auto i = common; i < longer.len; i++)
+      shorter.emplaceBackUnchecked(std::move(longer[i]));
+    longer.truncate(common);
+  }
+
+  friend constexpr void swap(StaticVec &lhs, StaticVec &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+  }
+
+private:
+  // as in SmallVec, makes `stack` the active union member during constant evaluation
+  constexpr void activateStack() noexcept {
+    if constexpr (std::is_default_constructible_v<T>) {
+      if (std::is_constant_evaluated()) {
+        std::construct_at(&impl, ActiveStack{});
+        std::destroy(impl.stack, impl.stack + N);
+      }
+    }
+  }
+
+  // destroys elements past `n`
+  constexpr void truncate(std::size_t n) noexcept {
+    if (n >= len)
+      return;
+    std::destroy(data() + n, data() + len);
+    len = static_cast<SizeType>(n);
+  }
+};
+
+template <typename T, std::size_t N>
+StaticVec(T(&&)[N]) -> StaticVec<T, N>;
+
+template <typename T, std::size_t N>
+StaticVec(T (&)[N]) -> StaticVec<T, N>;
+
+template <typename T, typename... U>
+StaticVec(T, U...) -> StaticVec<T, 1 + sizeof...(U)>;
+}// namespace smallvec
@@ -2,4 +2,12 @@
 // Created by tesserakt on 15.11.2021.
 //
 
+#include <string>
+
 #include "SmallVec.hpp"
+
+#define SMALLVEC_INSTANTIATE(T, N)                                       \
+  template class smallvec::detail::VecBase<smallvec::SmallVec<T, N>, T>; \
+  template class smallvec::SmallVec<T, N>;
+SMALLVEC_FOR_EACH_COMMON_INSTANTIATION(SMALLVEC_INSTANTIATE)
+#undef SMALLVEC_INSTANTIATE
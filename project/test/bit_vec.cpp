@@ -0,0 +1,108 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "SmallBitVec.hpp"
+
+using namespace smallvec;
+
+static_assert(sizeof(SmallBitVec<64>) == 24);
+static_assert(sizeof(SmallBitVec<64>) < sizeof(SmallVec<bool, 64>));
+
+constexpr std::size_t constexprFlags() {
+  SmallBitVec<64> flags(100);
+  flags.set(3);
+  flags.set(99);
+  return flags.popcount() * 1000 + flags.findNextSet(4);
+}
+
+static_assert(constexprFlags() == 2099);
+
+TEST(SmallBitVec, PushAndTest) {
+  SmallBitVec<64> bits;
+  std::vector<bool> expected;
+  for (int i = 0; i < 150; i++) {
+    bool value = i % 3 == 0 || i % 7 == 0;
+    bits.push(value);
+    expected.push_back(value);
+  }
+  EXPECT_EQ(bits.size(), 150u);
+  EXPECT_TRUE(bits.onHeap());
+  for (std::size_t i = 0; i < expected.size(); i++)
+    EXPECT_EQ(bits[i], expected[i]) << i;
+
+  bits.pop();
+  bits.pop();
+  EXPECT_EQ(bits.size(), 148u);
+  EXPECT_EQ(bits.popcount(), static_cast<std::size_t>(std::count(expected.begin(), expected.begin() + 148, true)));
+}
+
+TEST(SmallBitVec, StaysInline) {
+  SmallBitVec<128> bits(128, true);
+  EXPECT_TRUE(bits.onStack());
+  EXPECT_TRUE(bits.all());
+  EXPECT_EQ(bits.popcount(), 128u);
+  bits.push(false);
+  EXPECT_TRUE(bits.onHeap());
+  EXPECT_FALSE(bits.all());
+}
+
+TEST(SmallBitVec, PushWord) {
+  SmallBitVec<64> bits;
+  bits.pushWord(0b101, 3);
+  bits.pushWord(~SmallBitVec<64>::Word(0), 64);
+  bits.pushWord(0xFF, 4);
+  EXPECT_EQ(bits.size(), 71u);
+  EXPECT_TRUE(bits[0]);
+  EXPECT_FALSE(bits[1]);
+  EXPECT_TRUE(bits[2]);
+  EXPECT_EQ(bits.popcount(), 2u + 64 + 4);
+  ASSERT_EQ(bits.words().size(), 2u);
+  // the upper bits of the last word stay zero
+  EXPECT_EQ(bits.words()[1], 0x7Fu);
+}
+
+TEST(SmallBitVec, FindSet) {
+  SmallBitVec<64> bits(200);
+  EXPECT_EQ(bits.findFirstSet(), 200u);
+  EXPECT_TRUE(bits.none());
+  bits.set(70);
+  bits.set(130);
+  bits.set(199);
+  EXPECT_EQ(bits.findFirstSet(), 70u);
+  EXPECT_EQ(bits.findNextSet(71), 130u);
+  EXPECT_EQ(bits.findNextSet(131), 199u);
+  EXPECT_EQ(bits.findNextSet(200), 200u);
+
+  std::vector<std::size_t> set;
+  bits.forEachSet([&](std::size_t index) { set.push_back(index); });
+  EXPECT_EQ(set, (std::vector<std::size_t>{70, 130, 199}));
+  bits.flip(70);
+  bits.reset(130);
+  EXPECT_EQ(bits.findFirstSet(), 199u);
+}
+
+TEST(SmallBitVec, BitwiseOperations) {
+  SmallBitVec<64> a(70);
+  SmallBitVec<64> b(70);
+  for (std::size_t i = 0; i < 70; i += 2)
+    a.set(i);
+  for (std::size_t i = 0; i < 70; i += 3)
+    b.set(i);
+  EXPECT_EQ((a & b).popcount(), 12u);
+  EXPECT_EQ((a | b).popcount(), 35u + 24 - 12);
+  EXPECT_EQ((a ^ b).popcount(), 35u + 24 - 24);
+  EXPECT_EQ((~a).popcount(), 35u);
+  EXPECT_EQ(~~a, a);
+  EXPECT_NE(a, b);
+
+  a.resize(3);
+  EXPECT_EQ(a.popcount(), 2u);
+  a.resize(66, true);
+  EXPECT_EQ(a.popcount(), 65u);
+  EXPECT_EQ(a.words()[1], 0b11u);
+}
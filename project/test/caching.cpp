@@ -0,0 +1,95 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "CachingAllocator.hpp"
+
+using namespace smallvec;
+
+TEST(CachingAllocator, RecyclesSpilledBuffers) {
+  trimBufferCache();
+  resetBufferCacheStats();
+  int *first;
+  {
+    CachingSmallVec<int, 4> vec;
+    for (int i = 0; i < 10; i++)
+      vec.push(i);
+    first = vec.data();
+    EXPECT_EQ(vec.capacity(), 16u);
+  }
+  // grew through 8 and 16 elements, both buffers are kept
+  auto stats = bufferCacheStats();
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.recycled, 2u);
+  EXPECT_EQ(stats.cachedBytes, 96u);
+
+  CachingSmallVec<int, 4> vec;
+  for (int i = 0; i < 10; i++)
+    vec.push(i);
+  EXPECT_EQ(vec.data(), first);
+  stats = bufferCacheStats();
+  EXPECT_EQ(stats.hits, 2u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.cachedBytes, 32u);
+}
+
+TEST(CachingAllocator, ReportsTheWholeSizeClass) {
+  CachingAllocator<std::string> alloc;
+  auto [ptr, count] = alloc.allocateAtLeast(3);
+  EXPECT_EQ(count * sizeof(std::string), std::bit_ceil(3 * sizeof(std::string)));
+  alloc.deallocate(ptr, count);
+
+  // growing releases the old buffer into the cache and reuses it for other types of the same size
+  trimBufferCache();
+  resetBufferCacheStats();
+  CachingSmallVec<std::string, 1> strings;
+  for (int i = 0; i < 20; i++)
+    strings.push(std::to_string(i));
+  auto stats = bufferCacheStats();
+  EXPECT_EQ(stats.misses, stats.recycled + 1);
+  EXPECT_EQ(strings[19], "19");
+}
+
+TEST(CachingAllocator, IsBounded) {
+  trimBufferCache();
+  resetBufferCacheStats();
+  {
+    int values[] = {1, 2, 3, 4};
+    std::vector<CachingSmallVec<int, 1>> vecs(SMALLVEC_CACHE_BLOCKS_PER_CLASS + 4);
+    for (auto &vec : vecs)
+      vec.extendCopying(std::begin(values), std::end(values));
+  }
+  auto stats = bufferCacheStats();
+  EXPECT_EQ(stats.recycled, std::size_t(SMALLVEC_CACHE_BLOCKS_PER_CLASS));
+  EXPECT_EQ(stats.released, 4u);
+
+  CachingAllocator<char> alloc;
+  auto [large, count] = alloc.allocateAtLeast(SMALLVEC_CACHE_MAX_BYTES + 1);
+  EXPECT_EQ(count, SMALLVEC_CACHE_MAX_BYTES + 1u);
+  alloc.deallocate(large, count);
+  EXPECT_EQ(bufferCacheStats().released, 5u);
+
+  trimBufferCache();
+  EXPECT_EQ(bufferCacheStats().cachedBytes, 0u);
+}
+
+TEST(CachingAllocator, ThreadsHaveTheirOwnCache) {
+  auto *vec = new CachingSmallVec<int, 2>();
+  for (int i = 0; i < 8; i++)
+    vec->push(i);
+  std::size_t hitsOnThread = 0;
+  std::thread([&] {
+    // freed here, reused by this thread only
+    delete vec;
+    CachingSmallVec<int, 2> local;
+    for (int i = 0; i < 8; i++)
+      local.push(i);
+    hitsOnThread = bufferCacheStats().hits;
+  }).join();
+  EXPECT_EQ(hitsOnThread, 1u);
+}
@@ -0,0 +1,128 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SmallFlat.hpp"
+
+using namespace smallvec;
+
+constexpr int constexprSetSum() {
+  SmallFlatSet<int, 4> set;
+  for (int i : {5, 1, 4, 1, 3})
+    set.insert(i);
+  set.erase(4);
+  int sum = 0;
+  for (int key : set)
+    sum = sum * 10 + key;
+  return sum;
+}
+
+static_assert(constexprSetSum() == 135);
+
+TEST(SmallFlatSet, KeepsKeysSorted) {
+  SmallFlatSet<int, 8> set;
+  EXPECT_TRUE(set.insert(3).second);
+  EXPECT_TRUE(set.insert(1).second);
+  EXPECT_TRUE(set.insert(2).second);
+  EXPECT_FALSE(set.insert(2).second);
+  EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(set.contains(1));
+  EXPECT_FALSE(set.contains(4));
+  EXPECT_EQ(set.count(3), 1u);
+  EXPECT_EQ(set.erase(2), 1u);
+  EXPECT_EQ(set.erase(2), 0u);
+  EXPECT_EQ(set.find(3), set.begin() + 1);
+  EXPECT_TRUE(set.onStack());
+}
+
+TEST(SmallFlatSet, BinarySearchAboveThreshold) {
+  SmallFlatSet<std::string, 4> strings;
+  SmallFlatSet<int, 4> ints;
+  for (int i = 0; i < 100; i++) {
+    strings.insert(std::to_string(i * 7 % 100));
+    ints.insert(i * 7 % 100);
+  }
+  EXPECT_EQ(strings.size(), 100u);
+  EXPECT_TRUE(std::is_sorted(strings.begin(), strings.end()));
+  EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end()));
+  for (int i = 0; i < 100; i++) {
+    EXPECT_TRUE(strings.contains(std::to_string(i)));
+    EXPECT_EQ(ints.find(i) - ints.begin(), i);
+  }
+  EXPECT_FALSE(strings.contains("100"));
+  EXPECT_FALSE(ints.contains(100));
+  EXPECT_FALSE(ints.contains(-1));
+}
+
+TEST(SmallFlatSet, InsertSorted) {
+  SmallFlatSet<int, 8> set;
+  set.insert(5);
+  set.insert(1);
+  std::vector<int> batch{9, 5, 3, 3, 7, 0};
+  set.insertSorted(batch);
+  EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int>{0, 1, 3, 5, 7, 9}));
+  EXPECT_TRUE(set.onStack());
+
+  set.insertSorted(std::vector<int>{});
+  EXPECT_EQ(set.size(), 6u);
+  set.insertSorted(std::views::iota(0, 20));
+  EXPECT_EQ(set.size(), 20u);
+  EXPECT_TRUE(std::is_sorted(set.begin(), set.end()));
+}
+
+TEST(SmallFlatSet, Unsorted) {
+  SmallFlatSet<int, 4, UnsortedKeys> set;
+  for (int i : {3, 1, 2, 1})
+    set.insert(i);
+  EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int>{3, 1, 2}));
+  set.erase(3);
+  EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int>{2, 1}));
+  EXPECT_TRUE(set.contains(2));
+  EXPECT_FALSE(set.contains(3));
+}
+
+TEST(SmallFlatMap, Basics) {
+  SmallFlatMap<std::string, int, 4> map;
+  map["b"] = 2;
+  map["a"] = 1;
+  EXPECT_TRUE(map.tryEmplace("c", 3).second);
+  EXPECT_FALSE(map.tryEmplace("c", 4).second);
+  EXPECT_EQ(map.at("c"), 3);
+  EXPECT_FALSE(map.insertOrAssign("c", 5).second);
+  EXPECT_EQ(map.at("c"), 5);
+  EXPECT_FALSE(map.insert({"a", 10}).second);
+  EXPECT_EQ(map["a"], 1);
+  EXPECT_THROW(map.at("d"), std::out_of_range);
+  EXPECT_EQ(map.begin()->first, "a");
+  EXPECT_EQ(map.erase("b"), 1u);
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map.find("b"), map.end());
+}
+
+TEST(SmallFlatMap, InsertSortedKeepsExisting) {
+  SmallFlatMap<int, std::string, 4> map;
+  map[2] = "two";
+  std::map<int, std::string> batch{{1, "one"}, {2, "zwei"}, {3, "three"}};
+  map.insertSorted(batch);
+  ASSERT_EQ(map.size(), 3u);
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_EQ(map.at(2), "two");
+  EXPECT_EQ(map.at(3), "three");
+}
+
+TEST(SmallFlatMap, Unsorted) {
+  SmallFlatMap<int, int, 4, UnsortedKeys> map;
+  for (int i = 0; i < 10; i++)
+    map[9 - i] = i;
+  EXPECT_EQ(map.begin()->first, 9);
+  EXPECT_EQ(map.at(0), 9);
+  map.erase(map.find(9));
+  EXPECT_EQ(map.begin()->first, 0);
+  EXPECT_EQ(map.size(), 9u);
+}
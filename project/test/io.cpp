@@ -0,0 +1,106 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+
+#include "SmallString.hpp"
+#include "SmallVecIO.hpp"
+
+using namespace smallvec;
+
+struct Pipe {
+  int fds[2];
+
+  Pipe() { EXPECT_EQ(::pipe(fds), 0); }
+
+  ~Pipe() {
+    ::close(fds[0]);
+    ::close(fds[1]);
+  }
+
+  void write(std::string_view str) const {
+    EXPECT_EQ(::write(fds[1], str.data(), str.size()), static_cast<ssize_t>(str.size()));
+  }
+};
+
+TEST(SmallVecIO, Views) {
+  SmallVec<std::uint16_t, 4> vec({1, 2, 3});
+  EXPECT_EQ(vec.asSpan().size(), 3u);
+  EXPECT_EQ(vec.asSpan().data(), vec.data());
+  EXPECT_EQ(vec.asBytes().size(), 6u);
+  vec.asWritableBytes()[0] = std::byte(7);
+  EXPECT_EQ(vec[0] & 0xff, 7);
+  const auto &constVec = vec;
+  EXPECT_EQ(constVec.asSpan()[2], 3);
+}
+
+TEST(SmallVecIO, AppendFromFd) {
+  Pipe pipe;
+  pipe.write("hello ");
+  SmallVec<char, 8> vec{'>', ' '};
+  EXPECT_EQ(appendFromFd(vec, pipe.fds[0], 64), 6);
+  EXPECT_EQ(std::string_view(vec.data(), vec.size()), "> hello ");
+
+  pipe.write("world");
+  ::close(pipe.fds[1]);
+  pipe.fds[1] = ::open("/dev/null", O_WRONLY);
+  EXPECT_EQ(appendFromFd(vec, pipe.fds[0], 3), 3);
+  EXPECT_EQ(appendFromFd(vec, pipe.fds[0], 64), 2);
+  EXPECT_EQ(appendFromFd(vec, pipe.fds[0], 64), 0);
+  EXPECT_EQ(std::string_view(vec.data(), vec.size()), "> hello world");
+
+  SmallVec<std::uint8_t, 4> bytes;
+  bytes.push(1);
+  EXPECT_EQ(appendFromFd(bytes, -1, 16), -1);
+  EXPECT_EQ(errno, EBADF);
+  EXPECT_EQ(bytes.size(), 1u);
+}
+
+TEST(SmallVecIO, AppendFromFdUsesSpareCapacity) {
+  Pipe pipe;
+  pipe.write("0123456789");
+  SmallVec<std::uint8_t, 512> vec;
+  vec.push('>');
+  // a short read fits inline and allocates nothing
+  EXPECT_EQ(appendFromFd(vec, pipe.fds[0], 65536), 10);
+  EXPECT_EQ(vec.size(), 11u);
+  EXPECT_TRUE(vec.onStack());
+
+  // the rest of the inline buffer is filled before growing
+  std::string block(600, 'x');
+  pipe.write(block);
+  EXPECT_EQ(appendFromFd(vec, pipe.fds[0], 65536), 501);
+  EXPECT_TRUE(vec.onStack());
+  EXPECT_EQ(appendFromFd(vec, pipe.fds[0], 65536), 99);
+  EXPECT_EQ(vec.size(), 611u);
+  EXPECT_EQ(vec.capacity(), 512u + 65536u);
+}
+
+TEST(SmallVecIO, Iovecs) {
+  std::vector<SmallVec<std::uint8_t, 8>> messages(3);
+  messages[0].extendCopying(std::begin("ab"), std::end("ab") - 1);
+  messages[2].extendCopying(std::begin("cde"), std::end("cde") - 1);
+  auto iovecs = toIovecs(messages);
+  ASSERT_EQ(iovecs.size(), 2u);
+  EXPECT_EQ(iovecs[0].iov_base, messages[0].data());
+  EXPECT_EQ(iovecs[1].iov_len, 3u);
+
+  Pipe pipe;
+  EXPECT_EQ(::writev(pipe.fds[1], iovecs.data(), static_cast<int>(iovecs.size())), 5);
+  SmallString<16> received;
+  received.resizeForOverwrite(5);
+  EXPECT_EQ(::read(pipe.fds[0], received.data(), 5), 5);
+  EXPECT_EQ(received, "abcde");
+
+  std::array<SmallVec<int, 2>, 1> ints{SmallVec<int, 2>{1, 2, 3}};
+  EXPECT_EQ(toIovecs<1>(ints)[0].iov_len, 3 * sizeof(int));
+}
@@ -0,0 +1,131 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <unordered_set>
+
+#include "SmallString.hpp"
+
+using namespace smallvec;
+
+constexpr std::size_t constexprLength() {
+  SmallString<4> str("abc");
+  str += "defgh";
+  str += '!';
+  str.pop();
+  return str.size() * 10 + (str == "abcdefgh");
+}
+
+static_assert(constexprLength() == 81);
+
+TEST(SmallString, NullTerminated) {
+  SmallString<8> str;
+  EXPECT_STREQ(str.c_str(), "");
+  str.append("hello");
+  str.push(' ');
+  EXPECT_STREQ(str.c_str(), "hello ");
+  str.append(3, 'x');
+  EXPECT_STREQ(str.c_str(), "hello xxx");
+  EXPECT_TRUE(str.onHeap());
+  str.resize(4);
+  EXPECT_STREQ(str.c_str(), "hell");
+  str.resize(6, 'o');
+  EXPECT_STREQ(str.c_str(), "helloo");
+  str.clear();
+  EXPECT_STREQ(str.c_str(), "");
+  EXPECT_TRUE(str.empty());
+}
+
+TEST(SmallString, StaysInlineUpToN) {
+  SmallString<256> line;
+  for (int i = 0; i < 16; i++)
+    line.append("0123456789abcdef");
+  EXPECT_EQ(line.size(), 256u);
+  EXPECT_EQ(line.capacity(), 256u);
+  EXPECT_TRUE(line.onStack());
+  EXPECT_EQ(std::strlen(line.c_str()), 256u);
+  line.push('!');
+  EXPECT_TRUE(line.onHeap());
+  EXPECT_EQ(line.view().substr(254), "ef!");
+}
+
+TEST(SmallString, AppendFromItself) {
+  SmallString<4> str("abcd");
+  str.append(str.view().substr(1));
+  EXPECT_EQ(str, "abcdbcd");
+  str.append(str);
+  EXPECT_EQ(str, "abcdbcdabcdbcd");
+}
+
+TEST(SmallString, Numbers) {
+  SmallString<16> str;
+  str.appendNumber(-42).push(' ');
+  EXPECT_TRUE(str.onStack());
+  str.appendNumber(std::uint64_t(18446744073709551615u)).push(' ');
+  str.appendNumber(0.5);
+  EXPECT_EQ(str, "-42 18446744073709551615 0.5");
+  EXPECT_STREQ(str.c_str(), "-42 18446744073709551615 0.5");
+
+  // the inline buffer only has to fit the digits
+  SmallString<256> almostFull(240, 'x');
+  almostFull.appendNumber(7);
+  EXPECT_TRUE(almostFull.onStack());
+  EXPECT_EQ(almostFull.size(), 241u);
+}
+
+TEST(SmallString, Printf) {
+  SmallString<16> str("x=");
+  str.appendPrintf("%d", 7);
+  EXPECT_TRUE(str.onStack());
+  str.appendPrintf(", name=%s, pi=%.3f", "a rather long name", 3.14159);
+  EXPECT_EQ(str, "x=7, name=a rather long name, pi=3.142");
+  EXPECT_STREQ(str.c_str(), "x=7, name=a rather long name, pi=3.142");
+}
+
+#ifdef __cpp_lib_format
+TEST(SmallString, Format) {
+  SmallString<8> str("x=");
+  str.formatTo("{}", 7);
+  EXPECT_TRUE(str.onStack());
+  str.formatTo(", name={}, pi={:.3f}", "a rather long name", 3.14159);
+  EXPECT_EQ(str, "x=7, name=a rather long name, pi=3.142");
+  EXPECT_STREQ(str.c_str(), "x=7, name=a rather long name, pi=3.142");
+}
+#endif
+
+TEST(SmallString, MovedFromIsEmpty) {
+  SmallString<4> heap("spilled to the heap");
+  SmallString<4> inlined("abc");
+  SmallString<4> moved(std::move(heap));
+  EXPECT_EQ(moved, "spilled to the heap");
+  EXPECT_TRUE(heap.empty());
+  EXPECT_STREQ(heap.c_str(), "");
+  heap.append("x");
+  EXPECT_EQ(heap, "x");
+
+  moved = std::move(inlined);
+  EXPECT_EQ(moved, "abc");
+  EXPECT_EQ(inlined.size(), 0u);
+  inlined += "reused";
+  EXPECT_EQ(inlined, "reused");
+}
+
+TEST(SmallString, StandardInterop) {
+  SmallString<8> str;
+  std::string_view source = "back inserted";
+  std::copy(source.begin(), source.end(), std::back_inserter(str));
+  EXPECT_EQ(str, source);
+  std::string_view view = str;
+  EXPECT_EQ(view, "back inserted");
+  EXPECT_LT(str, "c");
+  EXPECT_EQ(str, SmallString<8>("back inserted"));
+
+  std::unordered_set<SmallString<8>> set;
+  set.insert(str);
+  EXPECT_EQ(set.count(SmallString<8>("back inserted")), 1u);
+}
@@ -0,0 +1,129 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <numeric>
+#include <string>
+
+#include "SmallSoAVec.hpp"
+
+using namespace smallvec;
+
+using Pairs = SmallSoAVec<8, int, int>;
+// tuple<int &, int &> only has a common reference with tuple<int, int> & since C++23
+#ifdef __cpp_lib_ranges_zip
+static_assert(std::random_access_iterator<Pairs::iterator>);
+static_assert(std::random_access_iterator<Pairs::const_iterator>);
+#else
+static_assert(std::input_or_output_iterator<Pairs::iterator>);
+static_assert(std::sized_sentinel_for<Pairs::iterator, Pairs::iterator>);
+static_assert(std::totally_ordered<Pairs::const_iterator>);
+#endif
+static_assert(std::is_same_v<std::iterator_traits<Pairs::iterator>::iterator_category, std::input_iterator_tag>);
+
+TEST(SmallSoAVec, ColumnsShareLength) {
+  SmallSoAVec<4, float, int, std::uint8_t> particles;
+  for (int i = 0; i < 3; i++)
+    particles.push(i * 0.5f, i, static_cast<std::uint8_t>(i));
+  EXPECT_TRUE(particles.onStack());
+  EXPECT_EQ(particles.size(), 3u);
+  EXPECT_EQ(particles.column<1>().size(), 3u);
+
+  auto ids = particles.column<1>();
+  EXPECT_EQ(std::accumulate(ids.begin(), ids.end(), 0), 3);
+  for (float &x : particles.column<0>())
+    x += 1;
+  EXPECT_FLOAT_EQ(std::get<0>(particles[2]), 2.0f);
+}
+
+TEST(SmallSoAVec, SpillsIntoOneAllocation) {
+  SmallSoAVec<2, std::uint8_t, double, std::string> vec;
+  for (int i = 0; i < 100; i++)
+    vec.push(static_cast<std::uint8_t>(i), i * 1.5, std::to_string(i));
+  EXPECT_TRUE(vec.onHeap());
+  EXPECT_GE(vec.capacity(), 100u);
+  // columns are laid out one after another in the heap block, each suitably aligned
+  auto bytes = reinterpret_cast<std::uintptr_t>(vec.column<0>().data());
+  auto doubles = reinterpret_cast<std::uintptr_t>(vec.column<1>().data());
+  EXPECT_EQ(doubles % alignof(double), 0u);
+  EXPECT_GE(doubles - bytes, vec.capacity());
+  for (int i = 0; i < 100; i++) {
+    auto [byte, value, name] = vec[i];
+    EXPECT_EQ(byte, i);
+    EXPECT_EQ(value, i * 1.5);
+    EXPECT_EQ(name, std::to_string(i));
+  }
+
+  vec.resize(2);
+  vec.shrink();
+  EXPECT_TRUE(vec.onStack());
+  EXPECT_EQ(vec.capacity(), 2u);
+  EXPECT_EQ(std::get<2>(vec.back()), "1");
+}
+
+TEST(SmallSoAVec, CopyMoveAndRemove) {
+  SmallSoAVec<2, int, std::string> vec;
+  vec.push(1, "one");
+  vec.push(2, "two");
+  vec.push(3, "three");
+  auto copy = vec;
+  EXPECT_EQ(std::get<1>(copy[2]), "three");
+
+  vec.swapRemove(0);
+  EXPECT_EQ(vec.size(), 2u);
+  EXPECT_EQ(std::get<1>(vec[0]), "three");
+
+  SmallSoAVec<2, int, std::string> moved(std::move(copy));
+  EXPECT_EQ(copy.size(), 0u);
+  EXPECT_TRUE(copy.onStack());
+  EXPECT_EQ(moved.size(), 3u);
+
+  SmallSoAVec<2, int, std::string> small;
+  small.push(7, "seven");
+  moved = std::move(small);
+  EXPECT_EQ(moved.size(), 1u);
+  EXPECT_TRUE(moved.onStack());
+  EXPECT_EQ(std::get<1>(moved[0]), "seven");
+  // the pushed values may refer to the vector itself
+  moved.push(std::get<0>(moved[0]), std::get<1>(moved[0]));
+  moved.push(std::get<0>(moved[0]), std::get<1>(moved[0]));
+  EXPECT_EQ(std::get<1>(moved[2]), "seven");
+}
+
+TEST(SmallSoAVec, ProxyIterator) {
+  SmallSoAVec<8, int, int> pairs;
+  for (int i = 0; i < 5; i++)
+    pairs.push(i, i * i);
+  int sum = 0;
+  for (auto [key, value] : pairs) {
+    value += 1;
+    sum += key;
+  }
+  EXPECT_EQ(sum, 10);
+  EXPECT_EQ(pairs.column<1>()[4], 17);
+  EXPECT_EQ(pairs.end() - pairs.begin(), 5);
+
+  const auto &view = pairs;
+  SmallSoAVec<8, int, int>::const_iterator it = pairs.begin();
+  EXPECT_EQ(std::get<1>(it[2]), 5);
+  EXPECT_EQ(std::get<0>(*(view.end() - 1)), 4);
+}
+
+TEST(SmallSoAVec, AllocatorAndPolicies) {
+  std::pmr::monotonic_buffer_resource resource;
+  BasicSmallSoAVec<2, std::pmr::polymorphic_allocator<std::byte>, FixedStepGrowth<8>, std::uint8_t, double, char> vec(&resource);
+  for (int i = 0; i < 20; i++)
+    vec.push(i * 0.25, static_cast<char>('a' + i));
+  EXPECT_TRUE(vec.onHeap());
+  EXPECT_EQ(vec.capacity(), 24u);
+  EXPECT_EQ(vec.getAllocator().resource(), &resource);
+  EXPECT_EQ(std::get<1>(vec[19]), 't');
+  EXPECT_EQ(decltype(vec)::maxSize(), 255u);
+
+  auto copy = vec;
+  EXPECT_EQ(copy.size(), 20u);
+  EXPECT_EQ(std::get<0>(copy.back()), 19 * 0.25);
+}
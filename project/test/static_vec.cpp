@@ -0,0 +1,119 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "StaticVec.hpp"
+
+using namespace smallvec;
+
+static_assert(sizeof(StaticVec<std::uint8_t, 15>) == 16);
+static_assert(sizeof(StaticVec<int, 4>) == 20);
+static_assert(std::is_trivially_destructible_v<StaticVec<int, 4>>);
+static_assert(!std::is_trivially_destructible_v<StaticVec<std::string, 4>>);
+
+constexpr StaticVec<int, 8> squares() {
+  StaticVec<int, 8> result;
+  for (int i = 0; result.tryPush(i * i); i++) {}
+  return result;
+}
+
+constexpr auto table = squares();
+static_assert(table.size() == 8);
+static_assert(table[7] == 49);
+
+constexpr int erasedSum() {
+  StaticVec<std::string, 4> vec{std::string("a"), std::string("bb"), std::string("ccc")};
+  vec.erase(vec.begin());
+  vec.insert(vec.begin(), std::string("dddd"));
+  int sum = 0;
+  for (const auto &item : vec)
+    sum += static_cast<int>(item.size());
+  return sum;
+}
+
+static_assert(erasedSum() == 9);
+
+TEST(StaticVec, ThrowsWhenFull) {
+  StaticVec<std::string, 2> vec;
+  vec.push(std::string("a"));
+  EXPECT_TRUE(vec.tryPush(std::string("b")));
+  EXPECT_FALSE(vec.tryPush(std::string("c")));
+  EXPECT_EQ(vec.tryEmplaceBack("d"), nullptr);
+  EXPECT_THROW(vec.push(std::string("e")), std::length_error);
+  EXPECT_EQ(vec.size(), 2);
+  EXPECT_EQ(vec.back(), "b");
+}
+
+TEST(StaticVec, CopyAndMove) {
+  StaticVec<std::string, 4> vec{std::string("a"), std::string("b")};
+  auto copy = vec;
+  EXPECT_EQ(copy[1], "b");
+  StaticVec<std::string, 4> moved(std::move(vec));
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_EQ(moved[0], "a");
+  copy.resize(4, "x");
+  moved = copy;
+  EXPECT_EQ(moved.size(), 4);
+  EXPECT_EQ(moved.popBack(), "x");
+}
+
+constexpr bool sharedApi() {
+  StaticVec<int, 8> vec{1, 2, 3};
+  int tail[] = {7, 8};
+  vec.insert(vec.begin() + 1, 2, 0);
+  vec.insert(vec.end(), std::begin(tail), std::end(tail));
+  StaticVec<int, 8> expected{1, 0, 0, 2, 3, 7, 8};
+  return vec == expected && vec.contains(7) && vec.count(0) == 2 && vec.find(2) == vec.begin() + 3
+      && vec.asSpan().size() == 7;
+}
+
+static_assert(sharedApi());
+
+TEST(StaticVec, InsertRanges) {
+  StaticVec<std::string, 6> vec{std::string("a"), std::string("d")};
+  std::string middle[] = {"b", "c"};
+  auto it = vec.insert(vec.begin() + 1, std::begin(middle), std::end(middle));
+  EXPECT_EQ(*it, "b");
+  vec.insert(vec.end(), 2, vec[0]);
+  EXPECT_EQ(vec, (StaticVec<std::string, 6>{std::string("a"), std::string("b"), std::string("c"),
+                                            std::string("d"), std::string("a"), std::string("a")}));
+  EXPECT_THROW(vec.insert(vec.begin(), 1, "x"), std::length_error);
+  EXPECT_EQ(vec.size(), 6);
+}
+
+TEST(StaticVec, Assign) {
+  StaticVec<std::string, 4> vec{std::string("a"), std::string("b"), std::string("c")};
+  std::string replacement[] = {"x", "y"};
+  vec.assign(std::begin(replacement), std::end(replacement));
+  EXPECT_EQ(vec, (StaticVec<std::string, 4>{std::string("x"), std::string("y")}));
+  vec.assign(4, vec[1]);
+  EXPECT_EQ(vec.count("y"), 4);
+  std::string tooMany[5];
+  EXPECT_THROW(vec.assign(std::begin(tooMany), std::end(tooMany)), std::length_error);
+  EXPECT_EQ(vec.size(), 4);
+}
+
+TEST(StaticVec, Swap) {
+  StaticVec<std::string, 4> lhs{std::string("a"), std::string("b"), std::string("c")};
+  StaticVec<std::string, 4> rhs{std::string("x")};
+  swap(lhs, rhs);
+  EXPECT_EQ(lhs, (StaticVec<std::string, 4>{std::string("x")}));
+  EXPECT_EQ(rhs, (StaticVec<std::string, 4>{std::string("a"), std::string("b"), std::string("c")}));
+  lhs.swap(rhs);
+  EXPECT_EQ(lhs.size(), 3);
+  EXPECT_EQ(rhs[0], "x");
+}
+
+TEST(StaticVec, Views) {
+  StaticVec<std::uint32_t, 4> vec{1u, 2u};
+  EXPECT_EQ(vec.asBytes().size(), 8u);
+  EXPECT_EQ(vec.asSpan().data(), vec.data());
+  EXPECT_EQ(vec.swapRemove(0), 1u);
+  EXPECT_EQ(vec[0], 2u);
+  EXPECT_EQ(vec.retain([](std::uint32_t x) { return x > 2; }), 1u);
+  EXPECT_TRUE(vec.asSpan().empty());
+}
@@ -0,0 +1,85 @@
+//
+// Created by tesserakt on 14.10.2026.
+//
+
+#ifndef SMALLVEC_ENABLE_STATS
+#define SMALLVEC_ENABLE_STATS
+#endif
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <new>
+#include <sstream>
+
+#include "SmallVec.hpp"
+
+using namespace smallvec;
+
+namespace {
+// only instantiated in this translation unit
+struct Sample {
+  int value;
+};
+}// namespace
+
+TEST(SmallVecStats, CountsSpillsAndFinalSizes) {
+  using Vec = SmallVec<Sample, 4>;
+  auto &stats = stats::of<Vec, Sample>();
+  stats.reset();
+  {
+    Vec small, large;
+    small.push(Sample{1});
+    for (int i = 0; i < 20; i++)
+      large.push(Sample{i});
+  }
+  EXPECT_EQ(stats.spills, 1);
+  // 8 -> 16 -> 32
+  EXPECT_EQ(stats.reallocations, 2);
+  EXPECT_EQ(stats.destroyed, 2);
+  EXPECT_EQ(stats.peakSize, 20);
+  EXPECT_EQ(stats.sizeHistogram[1], 1);
+  EXPECT_EQ(stats.sizeHistogram[5], 1);
+
+  std::ostringstream out;
+  stats::Registry::instance().dump(out);
+  EXPECT_NE(out.str().find("spills: 1, reallocations: 2"), std::string::npos);
+}
+
+TEST(SmallVecStats, SkipsMovedFromVectors) {
+  using Vec = SmallVec<Sample, 2>;
+  auto &stats = stats::of<Vec, Sample>();
+  stats.reset();
+  {
+    Vec heap, inlined, reused;
+    for (int i = 0; i < 5; i++)
+      heap.push(Sample{i});
+    inlined.push(Sample{0});
+    Vec fromHeap(std::move(heap));
+    Vec fromInline(std::move(inlined));
+    reused = std::move(fromInline);
+    fromInline.push(Sample{1});
+  }
+  EXPECT_EQ(stats.movedFrom, 3);
+  // fromHeap, reused and the refilled fromInline, the empty moved-from ones are skipped
+  EXPECT_EQ(stats.destroyed, 3);
+  EXPECT_EQ(stats.sizeHistogram[0], 0);
+  EXPECT_EQ(stats.sizeHistogram[1], 2);
+  EXPECT_EQ(stats.sizeHistogram[3], 1);
+}
+
+TEST(SmallVecStats, FreshVectorInMovedFromStorage) {
+  using Vec = SmallVec<Sample, 4>;
+  auto &stats = stats::of<Vec, Sample>();
+  stats.reset();
+  alignas(Vec) std::byte storage[sizeof(Vec)];
+  auto *moved = new (storage) Vec();
+  moved->push(Sample{0});
+  Vec target(std::move(*moved));
+  moved->~Vec();
+  // the marker left in the storage must not be mistaken for a move of the new vector
+  auto *fresh = new (storage) Vec();
+  fresh->~Vec();
+  EXPECT_EQ(stats.destroyed, 1);
+  EXPECT_EQ(stats.sizeHistogram[0], 1);
+}
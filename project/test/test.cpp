@@ -4,9 +4,714 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <forward_list>
+#include <sstream>
+#include <string>
+
+#include "MallocAllocator.hpp"
 #include "SmallVec.hpp"
 
+using namespace smallvec;
+
+namespace {
+struct Tracked {
+  static inline int alive = 0;
+
+  int value;
+
+  explicit Tracked(int value) : value(value) { alive++; }
+  Tracked(const Tracked &rhs) : value(rhs.value) { alive++; }
+  Tracked(Tracked &&rhs) noexcept : value(rhs.value) { alive++; }
+  Tracked &operator=(const Tracked &) = default;
+  Tracked &operator=(Tracked &&) noexcept = default;
+  ~Tracked() { alive--; }
+};
+}// namespace
+
+TEST(SmallVec, EmptyConstructsNothing) {
+  {
+    SmallVec<Tracked, 16> vec;
+    EXPECT_EQ(Tracked::alive, 0);
+    vec.push(Tracked(1));
+    vec.push(Tracked(2));
+    EXPECT_EQ(Tracked::alive, 2);
+    vec.pop();
+    EXPECT_EQ(Tracked::alive, 1);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(SmallVec, SpillsToHeap) {
+  {
+    SmallVec<Tracked, 2> vec;
+    for (int i = 0; i < 10; i++)
+      vec.push(Tracked(i));
+    EXPECT_TRUE(vec.onHeap());
+    EXPECT_EQ(Tracked::alive, 10);
+    for (int i = 0; i < 10; i++)
+      EXPECT_EQ(vec[i].value, i);
+    SmallVec<Tracked, 2> copy(vec);
+    EXPECT_EQ(Tracked::alive, 20);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(SmallVec, StringElements) {
+  SmallVec<std::string, 4> vec;
+  for (int i = 0; i < 8; i++)
+    vec.push(std::to_string(i));
+  vec.shrink();
+  EXPECT_EQ(vec.size(), 8);
+  EXPECT_EQ(vec[7], "7");
+}
+
+TEST(SmallVec, MoveStealsHeapBuffer) {
+  SmallVec<int, 2> vec;
+  for (int i = 0; i < 10; i++)
+    vec.push(i);
+  auto *buffer = vec.data();
+  SmallVec<int, 2> moved(std::move(vec));
+  EXPECT_EQ(moved.data(), buffer);
+  EXPECT_EQ(moved.size(), 10);
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_TRUE(vec.onStack());
+
+  vec.push(42);
+  vec = std::move(moved);
+  EXPECT_EQ(vec.data(), buffer);
+  EXPECT_EQ(vec[9], 9);
+  EXPECT_EQ(moved.size(), 0);
+}
+
+TEST(SmallVec, MoveRelocatesInlineElements) {
+  {
+    SmallVec<Tracked, 4> vec;
+    vec.push(Tracked(1));
+    vec.push(Tracked(2));
+    SmallVec<Tracked, 4> moved;
+    moved.push(Tracked(3));
+    moved = std::move(vec);
+    EXPECT_EQ(Tracked::alive, 2);
+    EXPECT_EQ(moved.size(), 2);
+    EXPECT_EQ(moved[1].value, 2);
+    EXPECT_EQ(vec.size(), 0);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+static_assert(isTriviallyRelocatable<int>);
+static_assert(isTriviallyRelocatable<std::unique_ptr<int>>);
+static_assert(!isTriviallyRelocatable<Tracked>);
+
+TEST(SmallVec, RelocatesUniquePtrs) {
+  SmallVec<std::unique_ptr<int>, 2> vec;
+  for (int i = 0; i < 10; i++)
+    vec.push(std::make_unique<int>(i));
+  for (int i = 0; i < 10; i++)
+    EXPECT_EQ(*vec[i], i);
+  while (vec.size() > 1)
+    vec.pop();
+  vec.shrink();
+  EXPECT_TRUE(vec.onStack());
+  EXPECT_EQ(*vec[0], 0);
+}
+
+TEST(SmallVec, ExtendCopiesTrivialRanges) {
+  int source[] = {1, 2, 3, 4, 5};
+  SmallVec<int, 2> vec;
+  vec.extendCopying(std::begin(source), std::end(source));
+  vec.extendConsuming(std::begin(source), std::end(source));
+  EXPECT_EQ(vec.size(), 10);
+  EXPECT_EQ(vec[4], 5);
+  EXPECT_EQ(vec[9], 5);
+}
+
+TEST(SmallVec, EmplaceBackConstructsInPlace) {
+  struct Point {
+    int x, y, z;
+  };
+  SmallVec<Point, 2> vec;
+  for (int i = 0; i < 4; i++) {
+    Point &point = vec.emplaceBack(i, i + 1, i + 2);
+    EXPECT_EQ(&point, &vec[i]);
+  }
+  EXPECT_EQ(vec[3].z, 5);
+
+  vec.reserve(10);
+  for (int i = 0; i < 10; i++)
+    vec.emplaceBackUnchecked(i, i, i);
+  vec.pushUnchecked(Point{1, 2, 3});
+  EXPECT_EQ(vec.size(), 15);
+}
+
+TEST(SmallVec, EmplaceBackOwnElementWhileGrowing) {
+  SmallVec<std::string, 1> vec;
+  vec.push(std::string(64, 'a'));
+  vec.emplaceBack(vec[0]);
+  EXPECT_EQ(vec[1], vec[0]);
+}
+
+TEST(SmallVec, PmrAllocatesFromResource) {
+  std::array<std::byte, 1024> buffer{};
+  std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  pmr::SmallVec<int, 4> vec(&resource);
+  for (int i = 0; i < 32; i++)
+    vec.push(i);
+  EXPECT_TRUE(vec.onHeap());
+  EXPECT_GE(static_cast<const void *>(vec.data()), static_cast<const void *>(buffer.data()));
+  EXPECT_LT(static_cast<const void *>(vec.data()), static_cast<const void *>(buffer.data() + buffer.size()));
+
+  auto copy = vec;
+  EXPECT_EQ(copy.getAllocator().resource(), std::pmr::get_default_resource());
+}
+
+TEST(SmallVec, PmrMoveBetweenResources) {
+  std::pmr::monotonic_buffer_resource first, second;
+  pmr::SmallVec<std::string, 2> lhs(&first), rhs(&second);
+  for (int i = 0; i < 8; i++)
+    rhs.push(std::to_string(i));
+  lhs = std::move(rhs);
+  EXPECT_EQ(lhs.getAllocator().resource(), &first);
+  EXPECT_EQ(lhs.size(), 8);
+  EXPECT_EQ(lhs[7], "7");
+  EXPECT_EQ(rhs.size(), 0);
+}
+
+TEST(SmallVec, Swap) {
+  SmallVec<std::string, 2> inlineVec, heapVec, otherInline;
+  inlineVec.push(std::string("a"));
+  otherInline.push(std::string("x"));
+  otherInline.push(std::string("y"));
+  for (int i = 0; i < 5; i++)
+    heapVec.push(std::to_string(i));
+
+  swap(inlineVec, heapVec);
+  EXPECT_TRUE(inlineVec.onHeap());
+  EXPECT_EQ(inlineVec.size(), 5);
+  EXPECT_EQ(heapVec.size(), 1);
+  EXPECT_EQ(heapVec[0], "a");
+
+  swap(heapVec, otherInline);
+  EXPECT_EQ(heapVec.size(), 2);
+  EXPECT_EQ(heapVec[1], "y");
+  EXPECT_EQ(otherInline[0], "a");
+}
+
+// counts which entry points of MallocAllocator SmallVec goes through
+template <typename T>
+struct CountingMallocAllocator : MallocAllocator<T> {
+  static inline int allocations = 0;
+  static inline int reallocations = 0;
+
+  CountingMallocAllocator() noexcept = default;
+
+  template <typename U>
+  CountingMallocAllocator(const CountingMallocAllocator<U> &) noexcept {}
+
+  AllocationResult<T *> allocateAtLeast(std::size_t n) {
+    allocations++;
+    return MallocAllocator<T>::allocateAtLeast(n);
+  }
+
+  AllocationResult<T *> reallocate(T *ptr, std::size_t oldCount, std::size_t n) {
+    reallocations++;
+    return MallocAllocator<T>::reallocate(ptr, oldCount, n);
+  }
+};
+
+TEST(SmallVec, MallocAllocatorReallocates) {
+  SmallVec<int, 4, CountingMallocAllocator<int>> vec;
+  for (int i = 0; i < 1000; i++) {
+    vec.push(i);
+    // exactly what the growth policy asked for, no malloc slack
+    EXPECT_EQ(vec.capacity(), std::max<std::size_t>(4, std::bit_ceil(vec.size())));
+  }
+  for (int i = 0; i < 1000; i++)
+    EXPECT_EQ(vec[i], i);
+  // spilled once to 8 elements, then grew in place up to 1024
+  EXPECT_EQ(CountingMallocAllocator<int>::allocations, 1);
+  EXPECT_EQ(CountingMallocAllocator<int>::reallocations, 7);
+
+  SmallVec<std::string, 2, CountingMallocAllocator<std::string>> strings;
+  for (int i = 0; i < 10; i++)
+    strings.push(std::to_string(i));
+  EXPECT_EQ(strings[9], "9");
+  // strings aren't trivially relocatable, so every growth allocates a new block
+  EXPECT_EQ(CountingMallocAllocator<std::string>::allocations, 3);
+  EXPECT_EQ(CountingMallocAllocator<std::string>::reallocations, 0);
+}
+
+static_assert(PowerOfTwoGrowth::next(4, 5, 1) == 8);
+static_assert(FactorGrowth<>::next(100, 101, 1) == 150);
+static_assert(FixedStepGrowth<64>::next(64, 65, 1) == 128);
+static_assert(SizeClassGrowth::next(16, 17, 4) == 20);
+static_assert(SizeClassGrowth::next(0, 129, 1) == 160);
+
+TEST(SmallVec, GrowthPolicy) {
+  SmallVec<int, 2, std::allocator<int>, FactorGrowth<>> vec;
+  for (int i = 0; i < 100; i++)
+    vec.push(i);
+  EXPECT_EQ(vec.capacity(), 141);
+
+  SmallVec<int, 2, std::allocator<int>, FixedStepGrowth<10>> stepped;
+  for (int i = 0; i < 11; i++)
+    stepped.push(i);
+  EXPECT_EQ(stepped.capacity(), 20);
+  EXPECT_EQ(stepped[10], 10);
+}
+
+static_assert(sizeof(void *) != 8 || sizeof(SmallVec<std::uint8_t, 8>) == 24);
+static_assert(sizeof(void *) != 8 || sizeof(CompactSmallVec<std::uint8_t, 8>) == 16);
+static_assert(sizeof(void *) != 8 || sizeof(CompactSmallVec<std::uint8_t, 8, std::uint16_t>) == 16);
+static_assert(sizeof(void *) != 8 || sizeof(CompactSmallVec<std::uint32_t, 4>) == 24);
+
+TEST(SmallVec, CompactSizeType) {
+  CompactSmallVec<int, 4, std::uint8_t> vec;
+  EXPECT_EQ(vec.maxSize(), 255);
+  for (int i = 0; i < 255; i++)
+    vec.push(i);
+  EXPECT_EQ(vec.capacity(), 255);
+  EXPECT_EQ(vec[254], 254);
+  EXPECT_THROW(vec.push(255), std::length_error);
+  EXPECT_EQ(vec.size(), 255);
+}
+
+static_assert(sizeof(void *) != 8 || SmallVecBytes<std::uint8_t>::inlineCapacity == 48);
+static_assert(sizeof(void *) != 8 || SmallVecBytes<int>::inlineCapacity == 12);
+static_assert(sizeof(void *) != 8 || SmallVecBytes<int, 64, std::uint32_t>::inlineCapacity == 14);
+static_assert(sizeof(void *) != 8 || SmallVecBytes<std::string, 128>::inlineCapacity == 3);
+static_assert(sizeof(SmallVecBytes<int>) <= 64);
+static_assert(sizeof(SmallVecBytes<std::uint8_t, 32, std::uint16_t>) <= 32);
+
+TEST(SmallVec, IntoVector) {
+  SmallVec<std::string, 2> vec;
+  for (int i = 0; i < 10; i++)
+    vec.push(std::to_string(i));
+  auto result = std::move(vec).intoVector();
+  EXPECT_EQ(result.size(), 10);
+  EXPECT_EQ(result[9], "9");
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_TRUE(vec.onStack());
+
+  SmallVec<int, 4> small{1, 2, 3};
+  EXPECT_EQ(std::move(small).intoVector(), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(SmallVec, FromVector) {
+  std::vector<std::string> source{"a", "b", "c"};
+  auto vec = fromContainer<2>(std::move(source));
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec[2], "c");
+  EXPECT_TRUE(source.empty());
+
+  auto ints = fromContainer<8>(std::vector<int>{1, 2, 3});
+  EXPECT_EQ(ints.size(), 3);
+  EXPECT_TRUE(ints.onStack());
+
+  std::pmr::vector<int> pmrSource{4, 5};
+  auto fromPmr = fromContainer<2>(std::move(pmrSource));
+  EXPECT_EQ(fromPmr[1], 5);
+  EXPECT_TRUE(pmrSource.empty());
+}
+
+TEST(SmallVec, Resize) {
+  SmallVec<int, 4> vec;
+  vec.resize(10);
+  EXPECT_EQ(vec.size(), 10);
+  EXPECT_EQ(vec[9], 0);
+  vec.resize(12, 7);
+  EXPECT_EQ(vec[11], 7);
+  vec.resize(3);
+  EXPECT_EQ(vec.size(), 3);
+
+  vec.resizeForOverwrite(64);
+  EXPECT_EQ(vec.size(), 64);
+  std::fill(vec.begin(), vec.end(), 1);
+  EXPECT_EQ(vec[63], 1);
+}
+
+TEST(SmallVec, AppendCopiesOfOwnElement) {
+  {
+    SmallVec<Tracked, 2> vec;
+    vec.push(Tracked(5));
+    vec.append(10, vec[0]);
+    EXPECT_EQ(vec.size(), 11);
+    EXPECT_EQ(vec[10].value, 5);
+    vec.resize(1, Tracked(0));
+    EXPECT_EQ(Tracked::alive, 1);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(SmallVec, AppendRange) {
+  SmallVec<int, 4> vec;
+  vec.appendRange(std::vector<int>{1, 2, 3});
+  vec.appendRange(std::forward_list<int>{4, 5});
+  vec.appendRange(std::views::iota(6, 9));
+  vec.appendRange(std::views::iota(9) | std::views::take_while([](int i) { return i < 12; }));
+  ASSERT_EQ(vec.size(), 11);
+  for (int i = 0; i < 11; i++)
+    EXPECT_EQ(vec[i], i + 1);
+
+  std::istringstream input("12 13 14");
+  vec.appendRange(std::views::istream<int>(input));
+  EXPECT_EQ(vec.size(), 14);
+  EXPECT_EQ(vec[13], 14);
+}
+
+TEST(SmallVec, ExtendFromInputIterators) {
+  std::istringstream input("a b c d e");
+  SmallVec<std::string, 2> vec;
+  vec.extendConsuming(std::istream_iterator<std::string>(input), std::istream_iterator<std::string>());
+  EXPECT_EQ(vec.size(), 5);
+  EXPECT_EQ(vec[4], "e");
+}
+
+TEST(SmallVec, ExtendIsAmortized) {
+  int chunk[] = {1, 2, 3};
+  SmallVec<int, 2> vec;
+  std::size_t reallocations = 0;
+  for (int i = 0; i < 100; i++) {
+    auto capacity = vec.capacity();
+    vec.extendCopying(std::begin(chunk), std::end(chunk));
+    reallocations += capacity != vec.capacity();
+  }
+  EXPECT_EQ(vec.size(), 300);
+  EXPECT_EQ(vec.capacity(), 512);
+  EXPECT_LE(reallocations, 9);
+
+  SmallVec<int, 2> exact;
+  exact.extendCopyingExact(std::begin(chunk), std::end(chunk));
+  exact.extendConsumingExact(std::begin(chunk), std::end(chunk));
+  EXPECT_EQ(exact.capacity(), 6);
+}
+
+TEST(SmallVec, InsertAndErase) {
+  SmallVec<int, 4> vec{1, 2, 3};
+  vec.insert(vec.begin(), 0);
+  vec.insert(vec.end(), 5);
+  auto it = vec.emplace(vec.begin() + 4, 4);
+  EXPECT_EQ(*it, 4);
+  int tail[] = {6, 7, 8};
+  vec.insert(vec.end(), std::begin(tail), std::end(tail));
+  vec.insert(vec.begin() + 1, 2, 9);
+  EXPECT_EQ(std::move(vec).intoVector(), (std::vector<int>{0, 9, 9, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+  vec = SmallVec<int, 4>{0, 1, 2, 3, 4, 5};
+  it = vec.erase(vec.begin() + 1, vec.begin() + 3);
+  EXPECT_EQ(*it, 3);
+  vec.erase(vec.begin());
+  EXPECT_EQ(std::move(vec).intoVector(), (std::vector<int>{3, 4, 5}));
+}
+
+TEST(SmallVec, InsertOwnElementWithSpareCapacity) {
+  SmallVec<int, 8> vec{10, 20, 30, 40};
+  vec.insert(vec.begin(), vec[2]);
+  EXPECT_EQ(std::vector<int>(vec.begin(), vec.end()), (std::vector<int>{30, 10, 20, 30, 40}));
+  vec.emplace(vec.begin() + 1, vec.back());
+  EXPECT_EQ(std::vector<int>(vec.begin(), vec.end()), (std::vector<int>{30, 40, 10, 20, 30, 40}));
+  EXPECT_TRUE(vec.onStack());
+}
+
+TEST(SmallVec, InsertCountOfOwnElement) {
+  SmallVec<int, 6> vec{10, 20, 30};
+  vec.insert(vec.begin() + 1, 2, vec[2]);
+  EXPECT_EQ(std::vector<int>(vec.begin(), vec.end()), (std::vector<int>{10, 30, 30, 20, 30}));
+  EXPECT_TRUE(vec.onStack());
+  // spilling moves the element the value refers to
+  vec.insert(vec.begin(), 3, vec[3]);
+  EXPECT_EQ(std::vector<int>(vec.begin(), vec.end()), (std::vector<int>{20, 20, 20, 10, 30, 30, 20, 30}));
+  EXPECT_TRUE(vec.onHeap());
+}
+
+TEST(SmallVec, InsertAndEraseNonTrivial) {
+  {
+    SmallVec<Tracked, 2> vec;
+    for (int i = 0; i < 5; i++)
+      vec.insert(vec.begin(), Tracked(i));
+    vec.insert(vec.begin() + 2, 2, vec[0]);
+    ASSERT_EQ(vec.size(), 7);
+    EXPECT_EQ(vec[0].value, 4);
+    EXPECT_EQ(vec[2].value, 4);
+    EXPECT_EQ(vec[4].value, 2);
+    vec.erase(vec.begin(), vec.begin() + 3);
+    EXPECT_EQ(vec[0].value, 4);
+    EXPECT_EQ(vec[1].value, 2);
+    EXPECT_EQ(Tracked::alive, 4);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(SmallVec, UnorderedRemoval) {
+  SmallVec<std::string, 4> vec{std::string("a"), std::string("b"), std::string("c"), std::string("d")};
+  EXPECT_EQ(vec.swapRemove(0), "a");
+  EXPECT_EQ(vec[0], "d");
+  vec.eraseUnordered(vec.begin() + 2);
+  EXPECT_EQ(vec.size(), 2);
+  EXPECT_EQ(vec[1], "b");
+}
+
+TEST(SmallVec, Retain) {
+  SmallVec<int, 4> vec;
+  for (int i = 0; i < 20; i++)
+    vec.push(i);
+  auto *buffer = vec.data();
+  EXPECT_EQ(vec.retain([](int i) { return i % 2 == 0; }), 10);
+  EXPECT_EQ(erase_if(vec, [](int i) { return i > 10; }), 4);
+  EXPECT_EQ(erase(vec, 4), 1);
+  EXPECT_EQ(vec.data(), buffer);
+  EXPECT_EQ(std::move(vec).intoVector(), (std::vector<int>{0, 2, 6, 8, 10}));
+}
+
+TEST(SmallVec, ElementLifetimes) {
+  auto shared = std::make_shared<int>(42);
+  SmallVec<std::shared_ptr<int>, 2> vec;
+  for (int i = 0; i < 4; i++)
+    vec.push(shared);
+  EXPECT_EQ(shared.use_count(), 5);
+  vec.pop();
+  EXPECT_EQ(shared.use_count(), 4);
+  auto last = vec.popBack();
+  EXPECT_EQ(last, shared);
+  EXPECT_EQ(shared.use_count(), 4);
+  auto capacity = vec.capacity();
+  vec.clear();
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_EQ(vec.capacity(), capacity);
+  EXPECT_EQ(shared.use_count(), 2);
+}
+
+TEST(SmallVec, ShrinkToFit) {
+  SmallVec<int, 4> vec;
+  for (int i = 0; i < 100; i++)
+    vec.push(i);
+  vec.resize(10);
+  vec.shrinkToFit();
+  EXPECT_EQ(vec.capacity(), 10);
+  vec.shrinkToFit(8);
+  EXPECT_EQ(vec.capacity(), 10);
+
+  vec.resize(2);
+  vec.shrinkToFit(32);
+  EXPECT_EQ(vec.capacity(), 10);
+  vec.shrinkToFit();
+  EXPECT_TRUE(vec.onStack());
+  EXPECT_EQ(vec.capacity(), 4);
+  vec.push(2);
+  vec.push(3);
+  EXPECT_EQ(vec.size(), 4);
+  EXPECT_EQ(vec[3], 3);
+}
+
+TEST(SmallVec, ReleaseMemory) {
+  SmallVec<std::string, 2> vec;
+  vec.resize(16);
+  vec.releaseMemory(16);
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_EQ(vec.capacity(), 16);
+  vec.resize(32);
+  vec.releaseMemory(16);
+  EXPECT_TRUE(vec.onStack());
+  EXPECT_EQ(vec.capacity(), 2);
+}
+
+static_assert(sizeof(PointerLayoutSmallVec<int, 4>) == sizeof(SmallVec<int, 4>) + sizeof(int *));
+
+TEST(SmallVec, PointerLayout) {
+  PointerLayoutSmallVec<std::string, 2> vec;
+  vec.push(std::string("a"));
+  EXPECT_TRUE(vec.onStack());
+  for (int i = 0; i < 8; i++)
+    vec.push(std::to_string(i));
+  EXPECT_TRUE(vec.onHeap());
+  EXPECT_EQ(vec[8], "7");
+
+  auto copy = vec;
+  EXPECT_NE(copy.data(), vec.data());
+  EXPECT_EQ(copy[8], "7");
+
+  PointerLayoutSmallVec<std::string, 2> moved(std::move(vec));
+  EXPECT_EQ(moved[0], "a");
+  vec.push(std::string("b"));
+  EXPECT_EQ(vec[0], "b");
+
+  swap(vec, moved);
+  EXPECT_EQ(vec.size(), 9);
+  EXPECT_EQ(moved[0], "b");
+  EXPECT_TRUE(moved.onStack());
+
+  vec.resize(1);
+  vec.shrinkToFit();
+  EXPECT_TRUE(vec.onStack());
+  EXPECT_EQ(vec[0], "a");
+  auto inlineCopy = vec;
+  EXPECT_EQ(inlineCopy[0], "a");
+}
+
+TEST(SmallVec, CopyAssignmentReusesBuffer) {
+  SmallVec<std::string, 2> scratch, message;
+  for (int i = 0; i < 10; i++)
+    scratch.push(std::to_string(i));
+  auto *buffer = scratch.data();
+  for (int i = 0; i < 4; i++)
+    message.push(std::string(32, 'a' + i));
+
+  scratch = message;
+  EXPECT_EQ(scratch.data(), buffer);
+  EXPECT_EQ(scratch.size(), 4);
+  EXPECT_EQ(scratch[3], std::string(32, 'd'));
+
+  message.resize(20, "x");
+  scratch = message;
+  EXPECT_EQ(scratch.size(), 20);
+  EXPECT_EQ(scratch[19], "x");
+  scratch = scratch;
+  EXPECT_EQ(scratch.size(), 20);
+}
+
+TEST(SmallVec, Assign) {
+  SmallVec<int, 4> vec{1, 2, 3};
+  vec.assign(2, 7);
+  EXPECT_EQ(std::move(vec).intoVector(), (std::vector<int>{7, 7}));
+
+  vec.assign(6, 1);
+  vec.assign(3, vec[0]);
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec.capacity(), 6);
+
+  std::vector<int> source{4, 5, 6, 7, 8};
+  vec.assign(source.begin(), source.end());
+  EXPECT_EQ(std::move(vec).intoVector(), source);
+
+  std::istringstream input("9 10");
+  vec.assign(std::istream_iterator<int>(input), std::istream_iterator<int>());
+  EXPECT_EQ(std::move(vec).intoVector(), (std::vector<int>{9, 10}));
+}
+
+namespace {
+// compares the vectorized searches with std::find and std::count for sizes around the vector widths
+template <typename T>
+void checkSearches() {
+  for (std::size_t n = 0; n < 80; n++) {
+    SmallVec<T, 16> vec;
+    for (std::size_t i = 0; i < n; i++)
+      vec.push(static_cast<T>(i % 7));
+    for (int needle = -1; needle < 8; needle++) {
+      auto value = static_cast<T>(needle);
+      EXPECT_EQ(vec.find(value), std::find(vec.begin(), vec.end(), value));
+      EXPECT_EQ(vec.contains(value), std::find(vec.begin(), vec.end(), value) != vec.end());
+      EXPECT_EQ(vec.count(value), static_cast<std::size_t>(std::count(vec.begin(), vec.end(), value)));
+    }
+  }
+}
+}// namespace
+
+TEST(SmallVec, Searches) {
+  checkSearches<std::uint8_t>();
+  checkSearches<std::int16_t>();
+  checkSearches<std::uint32_t>();
+  checkSearches<std::int64_t>();
+  checkSearches<float>();
+  checkSearches<double>();
+
+  SmallVec<std::string, 2> strings{std::string("a"), std::string("b"), std::string("a")};
+  EXPECT_EQ(strings.find("b"), strings.begin() + 1);
+  EXPECT_EQ(strings.count("a"), 2u);
+  EXPECT_FALSE(strings.contains("c"));
+
+  SmallVec<double, 4> nan{std::numeric_limits<double>::quiet_NaN(), -0.0};
+  EXPECT_FALSE(nan.contains(nan[0]));
+  EXPECT_EQ(nan.find(0.0), nan.begin() + 1);
+}
+
+TEST(SmallVec, Equality) {
+  SmallVec<int, 4> a{1, 2, 3};
+  SmallVec<int, 4> b{1, 2, 3};
+  EXPECT_EQ(a, b);
+  b.push(4);
+  EXPECT_NE(a, b);
+  a.push(5);
+  EXPECT_NE(a, b);
+  EXPECT_TRUE((SmallVec<int, 4>() == SmallVec<int, 4>()));
+
+  SmallVec<std::string, 1> strings{std::string("x"), std::string("y")};
+  auto copy = strings;
+  EXPECT_EQ(strings, copy);
+  copy[1] = "z";
+  EXPECT_NE(strings, copy);
+}
+
+// spills to the heap and back while being evaluated at compile time
+constexpr int constexprRoundTrip() {
+  SmallVec<int, 4> vec;
+  for (int i = 0; i < 10; i++)
+    vec.push(i);
+  int extra[] = {100, 200};
+  vec.insert(vec.begin() + 1, extra, extra + 2);
+  vec.erase(vec.begin() + 3, vec.begin() + 5);
+  SmallVec<int, 4> copy = vec;
+  copy.resize(3);
+  copy.shrink();
+  copy.swap(vec);
+  int sum = 0;
+  for (int item : copy)
+    sum += item;
+  return sum + static_cast<int>(vec.size()) * 1000 + vec.onStack();
+}
+
+static_assert(constexprRoundTrip() == 3000 + 1 + (0 + 100 + 200 + 3 + 4 + 5 + 6 + 7 + 8 + 9));
+
+constexpr std::size_t constexprStrings() {
+  SmallVec<std::string, 2> vec;
+  for (int i = 0; i < 5; i++)
+    vec.emplaceBack(20, static_cast<char>('a' + i));
+  vec.erase(vec.begin());
+  vec.insert(vec.begin(), std::string("x"));
+  return vec.size() * 100 + vec[0].size() + vec[1].size();
+}
+
+static_assert(constexprStrings() == 521);
+
+// builds an inline table, spills it to the heap and shrinks it back
+constexpr int constexprSpill() {
+  SmallVec<int, 4> table{1, 2, 3};
+  int inlineSum = table[0] + table[1] + table[2];
+  for (int i = 4; i <= 10; i++)
+    table.push(i);
+  bool spilled = table.onHeap();
+  table.resize(2);
+  table.shrink();
+  SmallVec<std::string, 2> names{std::string("a")};
+  names.push(std::string("b"));
+  names.push(std::string("c"));
+  SmallVec<std::string, 2> moved(std::move(names));
+  names.push(std::string("d"));
+  return inlineSum * 1000 + spilled * 100 + table.onStack() * 10 + static_cast<int>(moved.size() + names.size());
+}
+
+static_assert(constexprSpill() == 6114);
+
+constexpr auto primes = toArray([] {
+  SmallVec<int, 4> result;
+  for (int i = 2; i < 50; i++) {
+    if (std::ranges::none_of(result, [&](int p) { return i % p == 0; }))
+      result.push(i);
+  }
+  return result;
+});
+
+static_assert(primes.size() == 15);
+static_assert(primes[0] == 2 && primes[14] == 47);
+
+TEST(SmallVec, ConstexprMatchesRuntime) {
+  constexpr int roundTrip = constexprRoundTrip();
+  constexpr std::size_t strings = constexprStrings();
+  EXPECT_EQ(roundTrip, constexprRoundTrip());
+  EXPECT_EQ(strings, constexprStrings());
+}
+
 int main() {
   testing::InitGoogleTest();
   return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}